@@ -0,0 +1,12 @@
+#ifndef ALLOCATION_COUNTER_H
+#define ALLOCATION_COUNTER_H
+
+#include <cstdint>
+
+// Counts every call to the global operator new, aligned forms included. The render loop samples it
+// around the per-frame hot path to prove that path never touches the heap.
+namespace AllocationCounter {
+    uint64_t count();
+}
+
+#endif
@@ -0,0 +1,82 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// Keep the compiler from discarding a value that is only computed for timing
+template <class T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+    _ReadWriteBarrier();
+#endif
+}
+
+struct BenchmarkResult {
+    std::string name;
+    double nsPerOp;      // Median over batches
+    double minNsPerOp;
+    double maxNsPerOp;
+    uint64_t iterations;
+};
+
+// Runs body in batches sized to take about a millisecond each, for at least
+// minSeconds and five batches, and reports the median time per call.
+// batchEnd runs after every batch inside the timed region, e.g. to wait for the GPU.
+template <class Body, class BatchEnd>
+BenchmarkResult runBenchmark(const char* name, double minSeconds, Body body, BatchEnd batchEnd) {
+    typedef std::chrono::steady_clock Clock;
+    const double targetBatchNs = 1.0e6;
+
+    // Warm up caches and lazy driver work, then size the batch
+    uint64_t batchSize = 1;
+    for (;;) {
+        Clock::time_point start = Clock::now();
+        for (uint64_t i = 0; i < batchSize; i++)
+            body();
+        batchEnd();
+        double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        if (ns >= targetBatchNs || batchSize >= (1u << 30))
+            break;
+        batchSize *= ns > 0.0 ? std::min<uint64_t>(10, std::max<uint64_t>(2, (uint64_t)(targetBatchNs / ns))) : 10;
+    }
+
+    std::vector<double> samples;
+    double elapsedSeconds = 0.0;
+    while (elapsedSeconds < minSeconds || samples.size() < 5) {
+        Clock::time_point start = Clock::now();
+        for (uint64_t i = 0; i < batchSize; i++)
+            body();
+        batchEnd();
+        double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        samples.push_back(ns / batchSize);
+        elapsedSeconds += ns * 1.0e-9;
+    }
+
+    std::sort(samples.begin(), samples.end());
+    BenchmarkResult result;
+    result.name = name;
+    result.nsPerOp = samples[samples.size() / 2];
+    result.minNsPerOp = samples.front();
+    result.maxNsPerOp = samples.back();
+    result.iterations = batchSize * samples.size();
+    return result;
+}
+
+template <class Body>
+BenchmarkResult runBenchmark(const char* name, double minSeconds, Body body) {
+    return runBenchmark(name, minSeconds, body, [] {});
+}
+
+#endif
@@ -0,0 +1,434 @@
+// Benchmarks for the cluster's hot paths: gauge angle mapping, the gauge
+// tessellators, the vehicle simulation step, warning evaluation, and full
+// frames rendered headless through each gauge render path.
+//
+// Build from the repository root with every .cpp except main.cpp, plus this
+// file, glad.c and GLFW. Results are the median ns per operation over
+// repeated batches and can be written as JSON, saved as a baseline, and
+// compared against one; any regression past its threshold exits with 1.
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+#include <json/json.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "../ClusterRenderer.h"
+#include "../Gauge.h"
+#include "../GaugeGeometry.h"
+#include "../RenderTarget.h"
+#include "../SignalBus.h"
+#include "../Vehicle.h"
+
+// Same framebuffer size as the cluster window
+const int FRAME_WIDTH = 1360;
+const int FRAME_HEIGHT = 768;
+
+const double DEFAULT_MIN_SECONDS = 0.5;
+const double DEFAULT_THRESHOLD_PERCENT = 10.0;
+
+struct Options {
+    double minSeconds = DEFAULT_MIN_SECONDS;
+    double thresholdPercent = DEFAULT_THRESHOLD_PERCENT;
+    std::map<std::string, double> thresholdOverrides; // --threshold NAME=PERCENT
+    std::string filter;
+    const char* jsonPath = nullptr;
+    const char* baselinePath = nullptr;
+    const char* saveBaselinePath = nullptr;
+    bool frames = true;
+};
+
+static void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " [options]\n"
+              << "  --filter TEXT            Only run benchmarks whose name contains TEXT\n"
+              << "  --min-time SECONDS       Minimum measuring time per benchmark (default " << DEFAULT_MIN_SECONDS << ")\n"
+              << "  --no-frames              Skip the headless full-frame benchmarks\n"
+              << "  --json FILE              Write the results as JSON\n"
+              << "  --save-baseline FILE     Write the results as a baseline for later runs\n"
+              << "  --baseline FILE          Compare against a baseline; exit with 1 on a regression\n"
+              << "  --threshold PERCENT      Allowed slowdown against the baseline (default " << DEFAULT_THRESHOLD_PERCENT << ")\n"
+              << "  --threshold NAME=PERCENT Allowed slowdown for one benchmark; overrides the baseline's own\n"
+              << "  --help                   Show this help\n";
+}
+
+// Returns 0 to run, 1 on bad arguments, 2 after --help
+static int parseArguments(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--help" || arg == "-h") {
+            printUsage(argv[0]);
+            return 2;
+        }
+        else if (arg == "--no-frames") {
+            options.frames = false;
+        }
+        else if (arg == "--filter" && hasValue) {
+            options.filter = argv[++i];
+        }
+        else if (arg == "--min-time" && hasValue) {
+            options.minSeconds = std::atof(argv[++i]);
+            if (options.minSeconds <= 0.0) {
+                std::cerr << "ERROR::ARGS::INVALID_MIN_TIME " << argv[i] << std::endl;
+                return 1;
+            }
+        }
+        else if (arg == "--json" && hasValue) {
+            options.jsonPath = argv[++i];
+        }
+        else if (arg == "--save-baseline" && hasValue) {
+            options.saveBaselinePath = argv[++i];
+        }
+        else if (arg == "--baseline" && hasValue) {
+            options.baselinePath = argv[++i];
+        }
+        else if (arg == "--threshold" && hasValue) {
+            std::string value = argv[++i];
+            size_t separator = value.find('=');
+            double percent = std::atof(value.c_str() + (separator == std::string::npos ? 0 : separator + 1));
+            if (percent < 0.0) {
+                std::cerr << "ERROR::ARGS::INVALID_THRESHOLD " << value << std::endl;
+                return 1;
+            }
+            if (separator == std::string::npos)
+                options.thresholdPercent = percent;
+            else
+                options.thresholdOverrides[value.substr(0, separator)] = percent;
+        }
+        else {
+            std::cerr << "ERROR::ARGS::UNKNOWN_OPTION " << arg << std::endl;
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+class BenchmarkRunner {
+public:
+    explicit BenchmarkRunner(const Options& options) : options(options) {}
+
+    template <class Body, class BatchEnd>
+    void run(const char* name, Body body, BatchEnd batchEnd) {
+        if (!options.filter.empty() && std::string(name).find(options.filter) == std::string::npos)
+            return;
+        BenchmarkResult result = runBenchmark(name, options.minSeconds, body, batchEnd);
+        std::cout << std::left << std::setw(32) << result.name << std::right << std::fixed
+                  << std::setprecision(1) << std::setw(14) << result.nsPerOp << " ns/op"
+                  << "  (min " << result.minNsPerOp << ", max " << result.maxNsPerOp
+                  << ", " << result.iterations << " runs)\n";
+        results.push_back(result);
+    }
+
+    template <class Body>
+    void run(const char* name, Body body) {
+        run(name, body, [] {});
+    }
+
+    const std::vector<BenchmarkResult>& all() const { return results; }
+
+private:
+    const Options& options;
+    std::vector<BenchmarkResult> results;
+};
+
+static void runSimulationBenchmarks(BenchmarkRunner& runner) {
+    // Throttle held with periodic releases, so the step sees both branches
+    VehicleState vehicle;
+    vehicle.engineRunning = true;
+    vehicle.parkingBrake = false;
+    uint32_t step = 0;
+    runner.run("vehicle.update", [&] {
+        InputFrame input = {};
+        input.deltaTime = 1.0f / 60.0f;
+        if ((step++ & 255) < 192)
+            input.held = 1u << ACTION_THROTTLE;
+        updateVehicle(vehicle, input);
+        doNotOptimize(vehicle);
+    });
+
+    // Walk through states that light different tell-tale combinations
+    VehicleState states[4];
+    states[1].engineRunning = true;
+    states[1].parkingBrake = false;
+    states[2].fuel = 5.0f;
+    states[2].engineTemp = 125.0f;
+    states[2].oilPressure = 10.0f;
+    states[3].batteryVoltage = 11.0f;
+    states[3].turnSignalLeft = true;
+    states[3].lightsOn = true;
+    uint32_t index = 0;
+    runner.run("warnings.evaluate", [&] {
+        uint64_t mask = evaluateWarnings(states[index++ & 3]);
+        doNotOptimize(mask);
+    });
+}
+
+static void runTessellatorBenchmarks(BenchmarkRunner& runner) {
+    struct Layout { const char* suffix; GaugeType type; float startAngle, sweep; };
+    const Layout layouts[] = {
+        { "full", GaugeType::FULL_CIRCLE, -135.0f, 270.0f },
+        { "quadrant", GaugeType::QUADRANT_1, 0.0f, 90.0f },
+    };
+
+    for (const Layout& layout : layouts) {
+        GaugeTickConfig ticks = GaugeTickConfig::defaultFor(layout.type);
+        std::string circle = std::string("tessellate.circle.") + layout.suffix;
+        std::string tickMarks = std::string("tessellate.ticks.") + layout.suffix;
+        std::string glow = std::string("tessellate.glow.") + layout.suffix;
+
+        runner.run(circle.c_str(), [&] {
+            std::vector<float> vertices = GaugeTessellator::circle(layout.type, layout.startAngle, layout.sweep);
+            doNotOptimize(vertices.data());
+        });
+        runner.run(tickMarks.c_str(), [&] {
+            std::vector<float> vertices = GaugeTessellator::ticks(layout.type, layout.startAngle, layout.sweep, ticks);
+            doNotOptimize(vertices.data());
+        });
+        runner.run(glow.c_str(), [&] {
+            std::vector<float> vertices = GaugeTessellator::glow(layout.type, layout.startAngle, layout.sweep);
+            doNotOptimize(vertices.data());
+        });
+    }
+}
+
+// Needs a current GL context; gauges upload their meshes on construction
+static void runGaugeBenchmarks(BenchmarkRunner& runner) {
+    Gauge speedometer(-250.0f, -50.0f, 120.0f, GaugeType::FULL_CIRCLE);
+    Gauge fuelGauge(400.0f, -20.0f, 60.0f, GaugeType::QUADRANT_1);
+
+    float value = 0.0f;
+    runner.run("gauge.angle.full", [&] {
+        value += 0.001f;
+        if (value > 1.0f) value -= 1.0f;
+        float angle = speedometer.getAngleForValue(value);
+        doNotOptimize(angle);
+    });
+    runner.run("gauge.angle.quadrant", [&] {
+        value += 0.001f;
+        if (value > 1.0f) value -= 1.0f;
+        float angle = fuelGauge.getAngleForValue(value);
+        doNotOptimize(angle);
+    });
+}
+
+// Whole frames into an offscreen target; each batch ends with glFinish so
+// the time covers the GPU work and not just command submission. False when a
+// steady frame re-uploaded scene records.
+static bool runFrameBenchmarks(BenchmarkRunner& runner) {
+    RenderTarget target;
+    target.resize(FRAME_WIDTH, FRAME_HEIGHT);
+    ClusterRenderer renderer;
+
+    struct Path { const char* name; GaugeRenderPath path; };
+    const Path paths[] = {
+        { "frame.mesh", GaugeRenderPath::MESH },
+        { "frame.cached_face", GaugeRenderPath::CACHED_FACE },
+        { "frame.sdf", GaugeRenderPath::SDF },
+    };
+
+    for (const Path& path : paths) {
+        // Same drive for every path: engine on, throttle held, needles moving
+        VehicleState vehicle;
+        SignalBus signalBus;
+        vehicle.engineRunning = true;
+        vehicle.parkingBrake = false;
+        double time = 0.0;
+        renderer.setRenderPath(path.path);
+
+        runner.run(path.name, [&] {
+            InputFrame input = {};
+            input.deltaTime = 1.0f / 60.0f;
+            input.held = 1u << ACTION_THROTTLE;
+            updateVehicle(vehicle, input);
+            time += input.deltaTime;
+
+            target.bind();
+            signalBus.publish(vehicle, evaluateWarnings(vehicle));
+            renderer.render(signalBus, time, FRAME_WIDTH, FRAME_HEIGHT);
+        }, [] { glFinish(); });
+    }
+
+    // Parked: nothing changes, so every retained node is reused as it is
+    VehicleState parked;
+    SignalBus parkedBus;
+    parkedBus.publish(parked, evaluateWarnings(parked));
+    renderer.setRenderPath(GaugeRenderPath::CACHED_FACE);
+    // The first frame rebuilds the nodes for the new path and bus
+    target.bind();
+    renderer.render(parkedBus, 0.0, FRAME_WIDTH, FRAME_HEIGHT);
+    size_t uploadingFrames = 0;
+    runner.run("frame.cached_face.steady", [&] {
+        target.bind();
+        renderer.render(parkedBus, 0.0, FRAME_WIDTH, FRAME_HEIGHT);
+        if (renderer.retainedScene().lastUploadRecords() != 0)
+            uploadingFrames++;
+    }, [] { glFinish(); });
+
+    if (uploadingFrames != 0) {
+        std::cerr << "ERROR::BENCHMARK::STEADY_FRAME_UPLOADED " << uploadingFrames
+                  << " frame(s) re-uploaded scene records" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Gets a context the way the cluster's --headless mode does: the null platform
+// with a surfaceless EGL context, or a hidden window when that is missing
+static GLFWwindow* createHeadlessContext() {
+    bool nullPlatform = glfwPlatformSupported(GLFW_PLATFORM_NULL);
+    if (nullPlatform)
+        glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+    if (!glfwInit()) {
+        std::cerr << "ERROR::BENCHMARK::GLFW_INIT_FAILED" << std::endl;
+        return nullptr;
+    }
+
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    if (nullPlatform)
+        glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_EGL_CONTEXT_API);
+
+    GLFWwindow* window = glfwCreateWindow(FRAME_WIDTH, FRAME_HEIGHT, "Cluster Benchmark", NULL, NULL);
+    if (!window) {
+        std::cerr << "ERROR::BENCHMARK::CONTEXT_CREATION_FAILED" << std::endl;
+        glfwTerminate();
+        return nullptr;
+    }
+    glfwMakeContextCurrent(window);
+    glfwSwapInterval(0);
+
+    if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
+        std::cerr << "ERROR::BENCHMARK::GLAD_INIT_FAILED" << std::endl;
+        glfwDestroyWindow(window);
+        glfwTerminate();
+        return nullptr;
+    }
+    return window;
+}
+
+static nlohmann::json resultsJson(const std::vector<BenchmarkResult>& results, const std::string& renderer) {
+    nlohmann::json benchmarks = nlohmann::json::array();
+    for (const BenchmarkResult& result : results) {
+        benchmarks.push_back({
+            { "name", result.name },
+            { "nsPerOp", result.nsPerOp },
+            { "minNsPerOp", result.minNsPerOp },
+            { "maxNsPerOp", result.maxNsPerOp },
+            { "iterations", result.iterations }
+        });
+    }
+    return { { "renderer", renderer }, { "benchmarks", benchmarks } };
+}
+
+static bool writeJson(const char* path, const nlohmann::json& json) {
+    std::ofstream file(path);
+    if (!file) {
+        std::cerr << "ERROR::BENCHMARK::FILE_NOT_WRITABLE " << path << std::endl;
+        return false;
+    }
+    file << json.dump(2) << "\n";
+    return true;
+}
+
+// A baseline is a results file; an entry may carry "thresholdPercent" to
+// loosen or tighten the check for that benchmark. Returns the regression count,
+// or -1 when the baseline cannot be read.
+static int compareWithBaseline(const std::vector<BenchmarkResult>& results, const Options& options) {
+    std::ifstream file(options.baselinePath);
+    if (!file) {
+        std::cerr << "ERROR::BENCHMARK::BASELINE_NOT_FOUND " << options.baselinePath << std::endl;
+        return -1;
+    }
+    nlohmann::json baseline = nlohmann::json::parse(file, nullptr, false);
+    if (baseline.is_discarded() || !baseline.contains("benchmarks") || !baseline["benchmarks"].is_array()) {
+        std::cerr << "ERROR::BENCHMARK::BASELINE_INVALID " << options.baselinePath << std::endl;
+        return -1;
+    }
+
+    std::map<std::string, const nlohmann::json*> entries;
+    for (const nlohmann::json& entry : baseline["benchmarks"])
+        if (entry.contains("name") && entry.contains("nsPerOp"))
+            entries[entry["name"].get<std::string>()] = &entry;
+
+    std::cout << "\nAgainst baseline " << options.baselinePath << ":\n";
+    int regressions = 0;
+    for (const BenchmarkResult& result : results) {
+        std::map<std::string, const nlohmann::json*>::const_iterator found = entries.find(result.name);
+        if (found == entries.end()) {
+            std::cout << std::left << std::setw(32) << result.name << "  not in baseline\n";
+            continue;
+        }
+        const nlohmann::json& entry = *found->second;
+        double baselineNs = entry["nsPerOp"].get<double>();
+
+        double threshold = options.thresholdPercent;
+        if (entry.contains("thresholdPercent"))
+            threshold = entry["thresholdPercent"].get<double>();
+        std::map<std::string, double>::const_iterator overridden = options.thresholdOverrides.find(result.name);
+        if (overridden != options.thresholdOverrides.end())
+            threshold = overridden->second;
+
+        double changePercent = baselineNs > 0.0 ? (result.nsPerOp / baselineNs - 1.0) * 100.0 : 0.0;
+        bool regressed = changePercent > threshold;
+        if (regressed)
+            regressions++;
+
+        std::cout << std::left << std::setw(32) << result.name << std::right << std::fixed
+                  << std::setprecision(1) << std::setw(8) << std::showpos << changePercent << std::noshowpos
+                  << "%  (limit " << threshold << "%)" << (regressed ? "  REGRESSION" : "") << "\n";
+    }
+
+    if (regressions > 0)
+        std::cerr << "ERROR::BENCHMARK::REGRESSION " << regressions << " benchmark(s) over threshold" << std::endl;
+    return regressions;
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    int parsed = parseArguments(argc, argv, options);
+    if (parsed != 0)
+        return parsed == 2 ? 0 : 1;
+
+    BenchmarkRunner runner(options);
+    runSimulationBenchmarks(runner);
+    runTessellatorBenchmarks(runner);
+
+    GLFWwindow* window = createHeadlessContext();
+    if (!window)
+        return 1;
+    std::string rendererName = (const char*)glGetString(GL_RENDERER);
+    std::cout << "GL renderer: " << rendererName << "\n";
+
+    runGaugeBenchmarks(runner);
+    bool framesValid = !options.frames || runFrameBenchmarks(runner);
+
+    glfwDestroyWindow(window);
+    glfwTerminate();
+    if (!framesValid)
+        return 1;
+
+    nlohmann::json json = resultsJson(runner.all(), rendererName);
+    if (options.jsonPath && !writeJson(options.jsonPath, json))
+        return 1;
+    if (options.saveBaselinePath && !writeJson(options.saveBaselinePath, json))
+        return 1;
+
+    if (options.baselinePath) {
+        int regressions = compareWithBaseline(runner.all(), options);
+        if (regressions != 0)
+            return 1;
+    }
+    return 0;
+}
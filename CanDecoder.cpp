@@ -0,0 +1,280 @@
+#include "CanDecoder.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+
+// The cluster's own message layout, used until a DBC file is loaded
+static const char* defaultDbc = R"(VERSION ""
+
+BU_: Cluster
+
+BO_ 256 Powertrain: 8 Vector__XXX
+ SG_ VehicleSpeed : 0|16@1+ (0.01,0) [0|655.35] "km/h" Cluster
+ SG_ EngineSpeed : 16|16@1+ (1,0) [0|65535] "rpm" Cluster
+ SG_ EngineRunning : 32|1@1+ (1,0) [0|1] "" Cluster
+
+BO_ 257 Engine: 4 Vector__XXX
+ SG_ FuelLevel : 0|8@1+ (0.5,0) [0|127.5] "%" Cluster
+ SG_ CoolantTemp : 8|8@1+ (1,-40) [-40|215] "degC" Cluster
+ SG_ OilPressure : 16|8@1+ (0.5,0) [0|127.5] "psi" Cluster
+ SG_ BatteryVoltage : 24|8@1+ (0.1,0) [0|25.5] "V" Cluster
+
+BO_ 258 Body: 1 Vector__XXX
+ SG_ TurnLeft : 0|1@1+ (1,0) [0|1] "" Cluster
+ SG_ TurnRight : 1|1@1+ (1,0) [0|1] "" Cluster
+ SG_ Hazards : 2|1@1+ (1,0) [0|1] "" Cluster
+ SG_ Lights : 3|1@1+ (1,0) [0|1] "" Cluster
+ SG_ ParkingBrake : 4|1@1+ (1,0) [0|1] "" Cluster
+ SG_ Seatbelt : 5|1@1+ (1,0) [0|1] "" Cluster
+ SG_ AirConditioning : 6|1@1+ (1,0) [0|1] "" Cluster
+
+BA_DEF_ SG_ "ClusterField" STRING ;
+BA_ "ClusterField" SG_ 256 VehicleSpeed "speed";
+BA_ "ClusterField" SG_ 256 EngineSpeed "rpm";
+BA_ "ClusterField" SG_ 257 FuelLevel "fuel";
+BA_ "ClusterField" SG_ 257 CoolantTemp "engineTemp";
+BA_ "ClusterField" SG_ 258 AirConditioning "ac";
+)";
+
+static const uint32_t EXTENDED_ID_FLAG = 0x80000000u;
+
+CanDecoder::CanDecoder() : slotShift(32) {
+    parseDbc(defaultDbc, "built-in layout");
+}
+
+bool CanDecoder::loadDbc(const char* path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "ERROR::DBC::FILE_NOT_FOUND: " << path << "\n";
+        return false;
+    }
+    std::stringstream text;
+    text << file.rdbuf();
+    return parseDbc(text.str(), path);
+}
+
+// A signal as parsed, before it is compiled into the table
+struct ParsedSignal {
+    std::string name;
+    uint32_t messageId;
+    int startBit;
+    int length;
+    bool bigEndian;
+    bool isSigned;
+    float factor;
+    float offset;
+};
+
+static bool compileSignal(const ParsedSignal& parsed, VehicleField field, CanSignal& signal) {
+    if (parsed.length < 1 || parsed.length > 64 || parsed.startBit < 0 || parsed.startBit > 63)
+        return false;
+
+    int lowestBit; // Position in the byte order's 64-bit word, 0 = least significant
+    int lastByte;
+    if (parsed.bigEndian) {
+        // Motorola start bits name the most significant bit in the DBC's
+        // sawtooth numbering; count from the first byte's MSB instead
+        int msbIndex = (parsed.startBit / 8) * 8 + (7 - parsed.startBit % 8);
+        int lsbIndex = msbIndex + parsed.length - 1;
+        if (lsbIndex > 63)
+            return false;
+        lowestBit = 63 - lsbIndex;
+        lastByte = lsbIndex / 8;
+    }
+    else {
+        if (parsed.startBit + parsed.length > 64)
+            return false;
+        lowestBit = parsed.startBit;
+        lastByte = (parsed.startBit + parsed.length - 1) / 8;
+    }
+
+    signal.messageId = parsed.messageId;
+    signal.startBit = (uint16_t)parsed.startBit;
+    signal.length = (uint8_t)parsed.length;
+    signal.bigEndian = parsed.bigEndian;
+    signal.isSigned = parsed.isSigned;
+    signal.shift = (uint8_t)lowestBit;
+    signal.signShift = (uint8_t)(parsed.isSigned ? 64 - parsed.length : 0);
+    signal.requiredLength = (uint8_t)(lastByte + 1);
+    signal.mask = parsed.length == 64 ? ~(uint64_t)0 : (((uint64_t)1 << parsed.length) - 1);
+    signal.factor = parsed.factor;
+    signal.offset = parsed.offset;
+    signal.field = field;
+    return true;
+}
+
+bool CanDecoder::parseDbc(const std::string& text, const char* sourceName) {
+    std::vector<ParsedSignal> parsedSignals;
+    std::map<std::pair<uint32_t, std::string>, std::string> fieldAttributes;
+
+    std::istringstream lines(text);
+    std::string line;
+    int lineNumber = 0;
+    uint32_t messageId = 0;
+    bool inMessage = false;
+
+    while (std::getline(lines, line)) {
+        lineNumber++;
+        size_t begin = line.find_first_not_of(" \t");
+        if (begin == std::string::npos)
+            continue;
+        const char* p = line.c_str() + begin;
+
+        if (std::strncmp(p, "BO_ ", 4) == 0) {
+            unsigned long id;
+            if (std::sscanf(p + 4, "%lu", &id) != 1) {
+                std::cerr << "ERROR::DBC::BAD_MESSAGE: " << sourceName << ":" << lineNumber << "\n";
+                return false;
+            }
+            messageId = (uint32_t)id;
+            inMessage = true;
+        }
+        else if (std::strncmp(p, "SG_ ", 4) == 0) {
+            if (!inMessage) {
+                std::cerr << "ERROR::DBC::SIGNAL_OUTSIDE_MESSAGE: " << sourceName << ":" << lineNumber << "\n";
+                return false;
+            }
+            // SG_ <name> [M|m<n>] : <start>|<length>@<order><sign> (<factor>,<offset>) ...
+            const char* colon = std::strchr(p, ':');
+            if (!colon) {
+                std::cerr << "ERROR::DBC::BAD_SIGNAL: " << sourceName << ":" << lineNumber << "\n";
+                return false;
+            }
+            std::istringstream head(std::string(p + 4, colon));
+            std::string name, multiplexer;
+            head >> name >> multiplexer;
+
+            ParsedSignal parsed;
+            char order, sign;
+            if (std::sscanf(colon + 1, " %d|%d@%c%c (%f,%f)", &parsed.startBit, &parsed.length,
+                            &order, &sign, &parsed.factor, &parsed.offset) != 6 ||
+                (order != '0' && order != '1') || (sign != '+' && sign != '-')) {
+                std::cerr << "ERROR::DBC::BAD_SIGNAL: " << sourceName << ":" << lineNumber << "\n";
+                return false;
+            }
+            // Multiplexed signals only exist for some frames; not supported
+            if (!multiplexer.empty() && multiplexer[0] == 'm')
+                continue;
+
+            parsed.name = name;
+            parsed.messageId = messageId;
+            parsed.bigEndian = order == '0';
+            parsed.isSigned = sign == '-';
+            parsedSignals.push_back(parsed);
+        }
+        else if (std::strncmp(p, "BA_ \"ClusterField\" SG_ ", 23) == 0) {
+            unsigned long id;
+            char name[256], field[64];
+            if (std::sscanf(p + 23, "%lu %255s \"%63[^\"]\"", &id, name, field) != 3) {
+                std::cerr << "ERROR::DBC::BAD_ATTRIBUTE: " << sourceName << ":" << lineNumber << "\n";
+                return false;
+            }
+            fieldAttributes[std::make_pair((uint32_t)id, std::string(name))] = field;
+        }
+        else {
+            // Any other section ends the current message's signal list
+            inMessage = false;
+        }
+    }
+
+    // Compile the signals that drive a cluster field, grouped by message
+    std::vector<CanSignal> compiled;
+    for (const ParsedSignal& parsed : parsedSignals) {
+        VehicleField field;
+        std::map<std::pair<uint32_t, std::string>, std::string>::const_iterator attribute =
+            fieldAttributes.find(std::make_pair(parsed.messageId, parsed.name));
+        if (attribute != fieldAttributes.end()) {
+            if (!vehicleFieldFromName(attribute->second.c_str(), field)) {
+                std::cerr << "ERROR::DBC::UNKNOWN_FIELD: " << sourceName << ": " << parsed.name
+                          << " -> " << attribute->second << "\n";
+                return false;
+            }
+        }
+        else if (!vehicleFieldFromName(parsed.name.c_str(), field)) {
+            continue;
+        }
+
+        CanSignal signal;
+        if (!compileSignal(parsed, field, signal)) {
+            std::cerr << "ERROR::DBC::SIGNAL_OUT_OF_FRAME: " << sourceName << ": " << parsed.name << "\n";
+            return false;
+        }
+        compiled.push_back(signal);
+    }
+    std::stable_sort(compiled.begin(), compiled.end(),
+                     [](const CanSignal& a, const CanSignal& b) { return a.messageId < b.messageId; });
+
+    signals.swap(compiled);
+    messages.clear();
+    for (uint32_t i = 0; i < signals.size(); i++) {
+        if (messages.empty() || messages.back().id != signals[i].messageId)
+            messages.push_back({ signals[i].messageId, i, 0 });
+        messages.back().signalCount++;
+    }
+    buildIndex();
+    return true;
+}
+
+static uint32_t hashSlot(uint32_t id, uint32_t shift) {
+    // Fibonacci hashing; the top bits are the best mixed
+    return shift >= 32 ? 0 : (id * 2654435769u) >> shift;
+}
+
+void CanDecoder::buildIndex() {
+    // At most half full, so probes stay short
+    uint32_t bits = 1;
+    while ((1u << bits) < messages.size() * 2)
+        bits++;
+    slotShift = 32 - bits;
+    slots.assign((size_t)1 << bits, 0);
+
+    uint32_t slotMask = (1u << bits) - 1;
+    for (uint32_t i = 0; i < messages.size(); i++) {
+        uint32_t slot = hashSlot(messages[i].id, slotShift);
+        while (slots[slot] != 0)
+            slot = (slot + 1) & slotMask;
+        slots[slot] = i + 1;
+    }
+}
+
+const CanMessage* CanDecoder::find(uint32_t id) const {
+    uint32_t slotMask = (uint32_t)slots.size() - 1;
+    for (uint32_t slot = hashSlot(id, slotShift);; slot = (slot + 1) & slotMask) {
+        uint32_t entry = slots[slot];
+        if (entry == 0)
+            return nullptr;
+        if (messages[entry - 1].id == id)
+            return &messages[entry - 1];
+    }
+}
+
+uint32_t CanDecoder::decode(const CanFrame& frame, VehicleState& vehicle) const {
+    const CanMessage* message = find(frame.id | (frame.extended ? EXTENDED_ID_FLAG : 0));
+    if (!message)
+        return 0;
+
+    // The payload in both byte orders; every signal is a shift and mask of one
+    uint64_t words[2] = { 0, 0 };
+    for (int i = 0; i < 8; i++) {
+        words[0] |= (uint64_t)frame.data[i] << (8 * i);
+        words[1] = (words[1] << 8) | frame.data[i];
+    }
+
+    uint32_t fields = 0;
+    const CanSignal* signal = &signals[message->firstSignal];
+    const CanSignal* end = signal + message->signalCount;
+    for (; signal != end; signal++) {
+        if (signal->requiredLength > frame.length)
+            continue;
+        uint64_t raw = (words[signal->bigEndian] >> signal->shift) & signal->mask;
+        int64_t value = (int64_t)(raw << signal->signShift) >> signal->signShift;
+        setVehicleField(vehicle, signal->field, (float)value * signal->factor + signal->offset);
+        fields |= 1u << signal->field;
+    }
+    return fields;
+}
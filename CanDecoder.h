@@ -0,0 +1,85 @@
+#ifndef CAN_DECODER_H
+#define CAN_DECODER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Vehicle.h"
+
+// One classic CAN frame, independent of where it came from
+struct CanFrame {
+    uint32_t id;      // 11-bit or 29-bit identifier
+    bool extended;    // 29-bit identifier
+    uint8_t length;   // Data bytes, 0 to 8
+    uint8_t data[8];  // Zero past length
+};
+
+// One signal compiled for extraction: the payload is loaded once per frame as
+// a 64-bit word in each byte order, and the signal is a shift and a mask away
+struct CanSignal {
+    uint32_t messageId;     // DBC message ID, bit 31 set for extended frames
+    uint16_t startBit;      // As written in the DBC
+    uint8_t length;         // Bits
+    bool bigEndian;         // Motorola byte order (@0)
+    bool isSigned;
+    uint8_t shift;          // Right shift of the word in this byte order
+    uint8_t signShift;      // 64 - length for signed signals, else 0
+    uint8_t requiredLength; // Frames shorter than this do not carry the signal
+    uint64_t mask;
+    float factor;
+    float offset;
+    VehicleField field;
+};
+
+// Per message ID: where its signals sit in the flat signal table
+struct CanMessage {
+    uint32_t id;            // Bit 31 set for extended frames
+    uint32_t firstSignal;
+    uint32_t signalCount;
+};
+
+// Decodes CAN frames into VehicleState fields through tables compiled from a
+// DBC file. Messages are found through an open-addressing hash of the ID, and
+// a frame's signals are decoded in one loop over its slice of the table.
+//
+// A signal drives the cluster field named by its ClusterField attribute, e.g.
+//   BA_ "ClusterField" SG_ 256 VehicleSpeed "speed";
+// or, without one, the field whose name matches the signal's (case-insensitive).
+// Field names are listed in Vehicle.cpp. Signals that map to no field, and
+// multiplexed signals, are skipped.
+//
+// Until a DBC is loaded the cluster's own layout is used, all little-endian:
+//   0x100 Powertrain  bits 0-15 speed 0.01 km/h, 16-31 rpm, 32 engine running
+//   0x101 Engine      bytes 0-3: fuel 0.5 %, engine temperature 1 deg C - 40,
+//                     oil pressure 0.5 psi, battery voltage 0.1 V
+//   0x102 Body        bits 0-6: turn left, turn right, hazards, lights,
+//                     parking brake, seatbelt, AC
+class CanDecoder {
+public:
+    CanDecoder();
+
+    // Replace the tables with the signals of a DBC file or text
+    bool loadDbc(const char* path);
+    bool parseDbc(const std::string& text, const char* sourceName);
+
+    // Apply one frame; returns the mask of fields it set, 0 for unknown IDs
+    uint32_t decode(const CanFrame& frame, VehicleState& vehicle) const;
+
+    size_t messageCount() const { return messages.size(); }
+    size_t signalCount() const { return signals.size(); }
+
+private:
+    const CanMessage* find(uint32_t id) const;
+    void buildIndex();
+
+    std::vector<CanSignal> signals;  // Grouped by message
+    std::vector<CanMessage> messages;
+
+    // Open addressing: message index + 1 per slot, 0 for empty
+    std::vector<uint32_t> slots;
+    uint32_t slotShift;
+};
+
+#endif
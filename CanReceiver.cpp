@@ -0,0 +1,176 @@
+#include "CanReceiver.h"
+#include "IdleWake.h"
+#include "Profiler.h"
+
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+#ifdef __linux__
+#include <linux/can.h>
+#include <linux/can/raw.h>
+#include <net/if.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#endif
+
+CanReceiver::CanReceiver(const CanDecoder& decoder)
+    : socketFd(-1), decoder(decoder), idleWake(nullptr), received(0), dropped(0), stopRequested(false)
+{
+    CanSnapshot& initial = snapshots.writeBuffer();
+    initial.fields = 0;
+    initial.frames = 0;
+    snapshots.publish();
+    snapshots.update();
+}
+
+CanReceiver::~CanReceiver() {
+    stop();
+#ifdef __linux__
+    if (socketFd >= 0)
+        close(socketFd);
+#endif
+}
+
+void CanReceiver::start(IdleWake* wake) {
+    if (!isOpen() || thread.joinable())
+        return;
+    idleWake = wake;
+    stopRequested.store(false, std::memory_order_relaxed);
+    thread = std::thread(&CanReceiver::run, this);
+}
+
+void CanReceiver::stop() {
+    if (!thread.joinable())
+        return;
+    stopRequested.store(true, std::memory_order_relaxed);
+    thread.join();
+}
+
+#ifdef __linux__
+
+bool CanReceiver::open(const char* interfaceName) {
+    if (isOpen())
+        return true;
+
+    int fd = socket(PF_CAN, SOCK_RAW, CAN_RAW);
+    if (fd < 0) {
+        std::cerr << "ERROR::CAN::SOCKET_FAILED: " << strerror(errno) << "\n";
+        return false;
+    }
+
+    unsigned int interfaceIndex = if_nametoindex(interfaceName);
+    if (interfaceIndex == 0) {
+        std::cerr << "ERROR::CAN::INTERFACE_NOT_FOUND: " << interfaceName << "\n";
+        close(fd);
+        return false;
+    }
+
+    // Bounded wait so the thread notices stop(); kernel drop counter in every
+    // message; a larger buffer than the default for bursts
+    timeval timeout = { 0, 100000 };
+    int enable = 1;
+    int bufferBytes = ReceiveBufferBytes;
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    setsockopt(fd, SOL_SOCKET, SO_RXQ_OVFL, &enable, sizeof(enable));
+    setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &bufferBytes, sizeof(bufferBytes));
+
+    sockaddr_can address;
+    memset(&address, 0, sizeof(address));
+    address.can_family = AF_CAN;
+    address.can_ifindex = (int)interfaceIndex;
+    if (bind(fd, (sockaddr*)&address, sizeof(address)) < 0) {
+        std::cerr << "ERROR::CAN::BIND_FAILED: " << interfaceName << ": " << strerror(errno) << "\n";
+        close(fd);
+        return false;
+    }
+
+    socketFd = fd;
+    return true;
+}
+
+void CanReceiver::run() {
+    can_frame frames[BatchSize];
+    iovec buffers[BatchSize];
+    mmsghdr messages[BatchSize];
+    char control[BatchSize][CMSG_SPACE(sizeof(uint32_t))];
+
+    memset(messages, 0, sizeof(messages));
+    for (int i = 0; i < BatchSize; i++) {
+        buffers[i].iov_base = &frames[i];
+        buffers[i].iov_len = sizeof(can_frame);
+        messages[i].msg_hdr.msg_iov = &buffers[i];
+        messages[i].msg_hdr.msg_iovlen = 1;
+        messages[i].msg_hdr.msg_control = control[i];
+    }
+
+    VehicleState state;
+    uint32_t fields = 0;
+    uint64_t frameCount = 0;
+
+    while (!stopRequested.load(std::memory_order_relaxed)) {
+        for (int i = 0; i < BatchSize; i++)
+            messages[i].msg_hdr.msg_controllen = sizeof(control[i]);
+
+        // Blocks for the first frame only, then takes whatever else is queued
+        int count = recvmmsg(socketFd, messages, BatchSize, MSG_WAITFORONE, nullptr);
+        if (count < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+                continue;
+            std::cerr << "ERROR::CAN::RECEIVE_FAILED: " << strerror(errno) << "\n";
+            break;
+        }
+
+        PROFILE_ZONE("CanReceiver::batch");
+        VehicleState before = state;
+        uint32_t fieldsBefore = fields;
+        for (int i = 0; i < count; i++) {
+            const can_frame& raw = frames[i];
+            if (messages[i].msg_len < sizeof(can_frame) || (raw.can_id & (CAN_ERR_FLAG | CAN_RTR_FLAG)))
+                continue;
+
+            CanFrame frame;
+            frame.extended = (raw.can_id & CAN_EFF_FLAG) != 0;
+            frame.id = raw.can_id & (frame.extended ? CAN_EFF_MASK : CAN_SFF_MASK);
+            frame.length = raw.can_dlc <= 8 ? raw.can_dlc : 8;
+            memset(frame.data, 0, sizeof(frame.data));
+            memcpy(frame.data, raw.data, frame.length);
+            fields |= decoder.decode(frame, state);
+
+            // The kernel's running count of frames dropped on this socket
+            for (cmsghdr* message = CMSG_FIRSTHDR(&messages[i].msg_hdr); message;
+                 message = CMSG_NXTHDR(&messages[i].msg_hdr, message)) {
+                if (message->cmsg_level == SOL_SOCKET && message->cmsg_type == SO_RXQ_OVFL) {
+                    uint32_t overflows;
+                    memcpy(&overflows, CMSG_DATA(message), sizeof(overflows));
+                    dropped.store(overflows, std::memory_order_relaxed);
+                }
+            }
+        }
+        frameCount += count;
+        received.store(frameCount, std::memory_order_relaxed);
+
+        if (fields == fieldsBefore && state == before)
+            continue;
+
+        CanSnapshot& snapshot = snapshots.writeBuffer();
+        snapshot.state = state;
+        snapshot.fields = fields;
+        snapshot.frames = frameCount;
+        snapshots.publish();
+        if (idleWake)
+            idleWake->notify();
+    }
+}
+
+#else
+
+bool CanReceiver::open(const char* interfaceName) {
+    std::cerr << "ERROR::CAN::UNSUPPORTED_PLATFORM: SocketCAN needs Linux\n";
+    return false;
+}
+
+void CanReceiver::run() {}
+
+#endif
@@ -0,0 +1,70 @@
+#ifndef CAN_RECEIVER_H
+#define CAN_RECEIVER_H
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+#include "CanDecoder.h"
+#include "TripleBuffer.h"
+#include "Vehicle.h"
+
+class IdleWake; // Forward declaration
+
+// Everything decoded from the bus so far; fields marks the values the bus
+// has actually sent, the rest of state is left at its defaults
+struct CanSnapshot {
+    VehicleState state;
+    uint32_t fields;
+    uint64_t frames;
+};
+
+// Reads a SocketCAN interface (e.g. vcan0) on its own thread. Frames are
+// drained with recvmmsg in batches, decoded, and each batch that changed
+// something is published once through a triple buffer, so a loaded bus costs
+// the renderer nothing beyond picking up the newest snapshot. Linux only;
+// elsewhere open() fails.
+class CanReceiver {
+public:
+    static const int BatchSize = 64;
+    // Requested socket receive buffer; absorbs bursts while the thread is descheduled
+    static const int ReceiveBufferBytes = 1 << 20;
+
+    // The decoder must outlive the receiver
+    explicit CanReceiver(const CanDecoder& decoder);
+    ~CanReceiver();
+
+    CanReceiver(const CanReceiver&) = delete;
+    CanReceiver& operator=(const CanReceiver&) = delete;
+
+    bool open(const char* interfaceName);
+    bool isOpen() const { return socketFd >= 0; }
+
+    // The wake is notified after every batch that changed a field
+    void start(IdleWake* wake);
+    void stop();
+
+    // Renderer side
+    bool update() { return snapshots.update(); }
+    const CanSnapshot& latest() const { return snapshots.read(); }
+
+    uint64_t framesReceived() const { return received.load(std::memory_order_relaxed); }
+    // Frames the kernel dropped because the socket buffer was full
+    uint64_t framesDropped() const { return dropped.load(std::memory_order_relaxed); }
+
+private:
+    void run();
+
+    int socketFd;
+    const CanDecoder& decoder;
+    IdleWake* idleWake;
+
+    TripleBuffer<CanSnapshot> snapshots;
+
+    std::atomic<uint64_t> received;
+    std::atomic<uint64_t> dropped;
+    std::atomic<bool> stopRequested;
+    std::thread thread;
+};
+
+#endif
@@ -0,0 +1,223 @@
+#include "CandumpReplay.h"
+#include "IdleWake.h"
+#include "Profiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+static int hexDigit(char c) {
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    c |= 0x20;
+    if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+    return -1;
+}
+
+static bool isBlank(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+bool CandumpScanner::next(CandumpRecord& record) {
+    while (cursor < end) {
+        const char* line = cursor;
+        const char* lineEnd = (const char*)memchr(cursor, '\n', (size_t)(end - cursor));
+        if (!lineEnd)
+            lineEnd = end;
+        cursor = lineEnd < end ? lineEnd + 1 : end;
+
+        if (parseLine(line, lineEnd, record))
+            return true;
+
+        // Empty lines are not worth counting
+        while (line < lineEnd && isBlank(*line))
+            line++;
+        if (line < lineEnd)
+            skipped++;
+    }
+    return false;
+}
+
+bool CandumpScanner::parseLine(const char* p, const char* lineEnd, CandumpRecord& record) const {
+    while (p < lineEnd && isBlank(*p))
+        p++;
+
+    // (seconds.fraction)
+    if (p == lineEnd || *p++ != '(')
+        return false;
+    int64_t seconds = 0;
+    const char* digits = p;
+    while (p < lineEnd && *p >= '0' && *p <= '9')
+        seconds = seconds * 10 + (*p++ - '0');
+    if (p == digits || p == lineEnd || *p++ != '.')
+        return false;
+    int64_t microseconds = 0;
+    int fractionDigits = 0;
+    while (p < lineEnd && *p >= '0' && *p <= '9') {
+        if (fractionDigits < 6) {
+            microseconds = microseconds * 10 + (*p - '0');
+            fractionDigits++;
+        }
+        p++;
+    }
+    for (; fractionDigits < 6; fractionDigits++)
+        microseconds *= 10;
+    if (p == lineEnd || *p++ != ')')
+        return false;
+
+    // Interface name
+    while (p < lineEnd && isBlank(*p))
+        p++;
+    while (p < lineEnd && !isBlank(*p))
+        p++;
+    while (p < lineEnd && isBlank(*p))
+        p++;
+
+    // ID#DATA; candump writes standard IDs with 3 digits and extended ones with 8
+    uint32_t id = 0;
+    int idDigits = 0;
+    int value;
+    while (p < lineEnd && (value = hexDigit(*p)) >= 0) {
+        id = (id << 4) | (uint32_t)value;
+        idDigits++;
+        p++;
+    }
+    if (idDigits == 0 || idDigits > 8 || p == lineEnd || *p++ != '#')
+        return false;
+    // ID##FLAGSDATA is CAN FD, ID#R a remote frame
+    if (p < lineEnd && (*p == '#' || *p == 'R' || *p == 'r'))
+        return false;
+
+    CanFrame& frame = record.frame;
+    frame.id = id;
+    frame.extended = idDigits > 3;
+    frame.length = 0;
+    int high, low;
+    while (p + 1 < lineEnd && (high = hexDigit(p[0])) >= 0 && (low = hexDigit(p[1])) >= 0) {
+        if (frame.length == 8)
+            return false;
+        frame.data[frame.length++] = (uint8_t)((high << 4) | low);
+        p += 2;
+    }
+    while (p < lineEnd && isBlank(*p))
+        p++;
+    if (p != lineEnd)
+        return false;
+    memset(frame.data + frame.length, 0, sizeof(frame.data) - frame.length);
+
+    record.timestampUs = seconds * 1000000 + microseconds;
+    return true;
+}
+
+CandumpReplay::CandumpReplay(const CanDecoder& decoder)
+    : decoder(decoder), speed(1.0), startSeconds(0.0), idleWake(nullptr),
+      replayed(0), skipped(0), logMicroseconds(0), elapsed(0.0), done(false), stopRequested(false)
+{
+    CanSnapshot& initial = snapshots.writeBuffer();
+    initial.fields = 0;
+    initial.frames = 0;
+    snapshots.publish();
+    snapshots.update();
+}
+
+CandumpReplay::~CandumpReplay() {
+    stop();
+}
+
+bool CandumpReplay::open(const char* path) {
+    if (!file.open(path))
+        return false;
+    file.adviseSequential();
+    return true;
+}
+
+void CandumpReplay::start(double replaySpeed, double fastForwardSeconds, IdleWake* wake) {
+    if (!isOpen() || thread.joinable())
+        return;
+    speed = replaySpeed;
+    startSeconds = fastForwardSeconds;
+    idleWake = wake;
+    stopRequested.store(false, std::memory_order_relaxed);
+    done.store(false, std::memory_order_relaxed);
+    thread = std::thread(&CandumpReplay::run, this);
+}
+
+void CandumpReplay::stop() {
+    if (!thread.joinable())
+        return;
+    stopRequested.store(true, std::memory_order_relaxed);
+    thread.join();
+}
+
+void CandumpReplay::run() {
+    typedef std::chrono::steady_clock Clock;
+    // Long gaps in a log are slept in slices, so stop() is never held up
+    const Clock::duration maxSleep = std::chrono::milliseconds(100);
+
+    CandumpScanner scanner(file.data(), file.data() + file.size());
+    CandumpRecord record;
+    VehicleState state;
+    uint32_t fields = 0;
+    uint64_t frames = 0;
+    uint64_t unpublished = 0;
+    size_t released = 0;
+
+    int64_t firstUs = -1;
+    int64_t lastUs = 0;
+    int64_t startUs = (int64_t)(startSeconds * 1.0e6);
+    bool pacing = false;
+    Clock::time_point runStart = Clock::now();
+    Clock::time_point pacingStart;
+
+    auto publish = [&]() {
+        CanSnapshot& snapshot = snapshots.writeBuffer();
+        snapshot.state = state;
+        snapshot.fields = fields;
+        snapshot.frames = frames;
+        snapshots.publish();
+        unpublished = 0;
+
+        replayed.store(frames, std::memory_order_relaxed);
+        skipped.store(scanner.skippedLines(), std::memory_order_relaxed);
+        logMicroseconds.store(lastUs, std::memory_order_relaxed);
+        if (idleWake)
+            idleWake->notify();
+    };
+
+    while (!stopRequested.load(std::memory_order_relaxed) && scanner.next(record)) {
+        if (firstUs < 0)
+            firstUs = record.timestampUs;
+        lastUs = record.timestampUs - firstUs;
+
+        // Past the fast-forward point, hold each frame until its time comes
+        if (speed > 0.0 && lastUs >= startUs) {
+            if (!pacing) {
+                pacing = true;
+                pacingStart = Clock::now();
+            }
+            Clock::time_point due = pacingStart + std::chrono::duration_cast<Clock::duration>(
+                std::chrono::duration<double>((lastUs - startUs) * 1.0e-6 / speed));
+            if (due > Clock::now() && unpublished > 0)
+                publish(); // Show everything decoded so far before waiting
+            for (Clock::time_point now = Clock::now(); due > now && !stopRequested.load(std::memory_order_relaxed);
+                 now = Clock::now())
+                std::this_thread::sleep_for(std::min<Clock::duration>(due - now, maxSleep));
+        }
+
+        fields |= decoder.decode(record.frame, state);
+        frames++;
+        if (++unpublished >= PublishInterval)
+            publish();
+
+        // Replayed pages are no longer needed in this process
+        if (scanner.offset() - released >= ReleaseChunkBytes) {
+            file.release(released, scanner.offset() - released);
+            released = scanner.offset();
+        }
+    }
+
+    publish();
+    elapsed.store(std::chrono::duration<double>(Clock::now() - runStart).count(), std::memory_order_relaxed);
+    done.store(true, std::memory_order_release);
+}
@@ -0,0 +1,105 @@
+#ifndef CANDUMP_REPLAY_H
+#define CANDUMP_REPLAY_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+#include "CanDecoder.h"
+#include "CanReceiver.h"
+#include "MappedFile.h"
+#include "TripleBuffer.h"
+
+class IdleWake; // Forward declaration
+
+// One line of a candump log file, as written by candump -l or -L:
+//   (1436509052.249713) can0 123#DEADBEEF
+struct CandumpRecord {
+    int64_t timestampUs;
+    CanFrame frame;
+};
+
+// Walks candump log lines in place, without copying or allocating. Remote
+// frames, CAN FD frames and malformed lines are counted and skipped.
+class CandumpScanner {
+public:
+    CandumpScanner(const char* begin, const char* end)
+        : begin(begin), cursor(begin), end(end), skipped(0) {}
+
+    // False once the end is reached
+    bool next(CandumpRecord& record);
+
+    size_t offset() const { return (size_t)(cursor - begin); }
+    uint64_t skippedLines() const { return skipped; }
+
+private:
+    bool parseLine(const char* line, const char* lineEnd, CandumpRecord& record) const;
+
+    const char* begin;
+    const char* cursor;
+    const char* end;
+    uint64_t skipped;
+};
+
+// Replays a memory-mapped candump log through a CanDecoder on its own thread,
+// at the log's own timing scaled by a speed factor or as fast as possible.
+// Results are published like CanReceiver's, so the renderer treats both alike.
+// Pages already replayed are dropped from the process as it goes, so logs
+// larger than RAM replay in bounded memory.
+class CandumpReplay {
+public:
+    // Snapshots published per this many frames when not waiting on the clock
+    static const uint32_t PublishInterval = 4096;
+    // Mapped pages behind the scanner are released in steps of this size
+    static const size_t ReleaseChunkBytes = 64 << 20;
+
+    // The decoder must outlive the replay
+    explicit CandumpReplay(const CanDecoder& decoder);
+    ~CandumpReplay();
+
+    CandumpReplay(const CandumpReplay&) = delete;
+    CandumpReplay& operator=(const CandumpReplay&) = delete;
+
+    bool open(const char* path);
+    bool isOpen() const { return file.isOpen(); }
+
+    // speed 1 keeps the recorded timing, 0 runs as fast as possible. Frames in
+    // the first startSeconds of the log are decoded without waiting, to
+    // fast-forward to an incident.
+    void start(double speed, double startSeconds, IdleWake* wake);
+    void stop();
+
+    bool finished() const { return done.load(std::memory_order_acquire); }
+
+    // Renderer side
+    bool update() { return snapshots.update(); }
+    const CanSnapshot& latest() const { return snapshots.read(); }
+
+    uint64_t framesReplayed() const { return replayed.load(std::memory_order_relaxed); }
+    uint64_t linesSkipped() const { return skipped.load(std::memory_order_relaxed); }
+    // Log time covered so far and the wall time it took
+    double logSeconds() const { return logMicroseconds.load(std::memory_order_relaxed) * 1.0e-6; }
+    double elapsedSeconds() const { return elapsed.load(std::memory_order_relaxed); }
+
+private:
+    void run();
+
+    const CanDecoder& decoder;
+    MappedFile file;
+    double speed;
+    double startSeconds;
+    IdleWake* idleWake;
+
+    TripleBuffer<CanSnapshot> snapshots;
+
+    std::atomic<uint64_t> replayed;
+    std::atomic<uint64_t> skipped;
+    std::atomic<int64_t> logMicroseconds;
+    std::atomic<double> elapsed;
+    std::atomic<bool> done;
+    std::atomic<bool> stopRequested;
+    std::thread thread;
+};
+
+#endif
@@ -0,0 +1,552 @@
+#include "ClusterRenderer.h"
+#include "SignalBus.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <string>
+#include <vector>
+
+// Enhanced vertex shader with better lighting support
+static const char* vertexShaderSrc = R"(
+#version 330 core
+layout(location = 0) in vec2 aPos;
+
+layout(std140) uniform FrameBlock {
+    vec2 resolution;
+    vec2 viewExtent;
+    float time;
+    int mode;
+};
+
+layout(std140) uniform DrawBlock {
+    vec2 offset;
+    vec2 scale;
+    vec3 color;
+    float alpha;
+    float rotation;
+    float textured;
+};
+
+out vec2 vUV;
+
+void main()
+{
+    // Only meaningful for the [-1, 1] face quad
+    vUV = aPos * 0.5 + 0.5;
+
+    float cosR = cos(rotation);
+    float sinR = sin(rotation);
+    vec2 rotatedPos = vec2(
+        aPos.x * cosR - aPos.y * sinR,
+        aPos.x * sinR + aPos.y * cosR
+    );
+
+    vec2 scaledPos = rotatedPos * scale;
+    vec2 finalPos = scaledPos + offset;
+
+    gl_Position = vec4(finalPos / viewExtent, 0.0, 1.0);
+}
+)";
+
+// Enhanced fragment shader with better color support
+static const char* fragmentShaderSrc = R"(
+#version 330 core
+in vec2 vUV;
+out vec4 FragColor;
+
+layout(std140) uniform DrawBlock {
+    vec2 offset;
+    vec2 scale;
+    vec3 color;
+    float alpha;
+    float rotation;
+    float textured;
+};
+
+uniform sampler2D faceTexture;
+
+void main()
+{
+    if (textured > 0.5) {
+        // Baked faces hold premultiplied color
+        vec4 texel = texture(faceTexture, vUV);
+        FragColor = vec4(texel.rgb / max(texel.a, 1e-4), texel.a * alpha);
+    } else {
+        FragColor = vec4(color, alpha);
+    }
+}
+)";
+
+// Batched rectangles carry their color per vertex
+static const char* quadVertexShaderSrc = R"(
+#version 330 core
+layout(location = 0) in vec2 aPos;
+layout(location = 1) in vec4 aColor;
+
+layout(std140) uniform FrameBlock {
+    vec2 resolution;
+    vec2 viewExtent;
+    float time;
+    int mode;
+};
+
+out vec4 vColor;
+
+void main()
+{
+    vColor = aColor;
+    gl_Position = vec4(aPos / viewExtent, 0.0, 1.0);
+}
+)";
+
+static const char* quadFragmentShaderSrc = R"(
+#version 330 core
+in vec4 vColor;
+out vec4 FragColor;
+
+void main()
+{
+    FragColor = vColor;
+}
+)";
+
+// Instanced tell-tales: blink state is derived from FrameBlock time
+static const char* warningVertexShaderSrc = R"(
+#version 330 core
+layout(location = 0) in vec2 aCorner;
+layout(location = 1) in vec2 aPosition;
+layout(location = 2) in vec3 aColor;
+layout(location = 3) in uint aFlags;
+
+layout(std140) uniform FrameBlock {
+    vec2 resolution;
+    vec2 viewExtent;
+    float time;
+    int mode;
+};
+
+uniform uvec2 activeMask;
+uniform float lightSize;
+
+out vec4 vColor;
+
+void main()
+{
+    uint word = gl_InstanceID < 32 ? activeMask.x : activeMask.y;
+    bool lit = ((word >> uint(gl_InstanceID & 31)) & 1u) != 0u;
+    bool blinkOn = fract(time) < 0.5;
+
+    // Turn signals are only lit during the on-phase
+    if ((aFlags & 1u) != 0u)
+        lit = lit && blinkOn;
+
+    vColor = lit ? vec4(aColor, blinkOn ? 1.0 : 0.3) : vec4(0.2, 0.2, 0.2, 0.3);
+
+    vec2 pos = aPosition + aCorner * lightSize;
+    gl_Position = vec4(pos / viewExtent, 0.0, 1.0);
+}
+)";
+
+// Prefix shared by both SDF gauge stages; the array size must match SdfGaugeRenderer::MaxGauges
+static const char* sdfGaugeBlockSrc = R"(
+#version 330 core
+struct SdfGauge {
+    vec4 geometry;   // center.xy, radius, quad half size
+    vec4 arc;        // start angle, signed sweep, needle angle, flags
+    vec4 ticks;      // major count, minor per major, major inner, major outer
+    vec4 scales;     // face, hub, minor inner, minor outer
+    vec4 bezelColor;
+    vec4 faceColor;
+    vec4 glowColor;
+    vec4 tickColor;
+    vec4 needleColor;
+    vec4 hubColor;
+};
+
+layout(std140) uniform SdfBlock {
+    SdfGauge gauges[16];
+};
+)";
+
+static const char* sdfVertexShaderSrc = R"(
+layout(location = 0) in vec2 aCorner;
+
+layout(std140) uniform FrameBlock {
+    vec2 resolution;
+    vec2 viewExtent;
+    float time;
+    int mode;
+};
+
+flat out int vGauge;
+out vec2 vLocal;
+
+void main()
+{
+    SdfGauge g = gauges[gl_InstanceID];
+    vGauge = gl_InstanceID;
+    vLocal = aCorner * g.geometry.w;
+    gl_Position = vec4((g.geometry.xy + vLocal) / viewExtent, 0.0, 1.0);
+}
+)";
+
+static const char* sdfFragmentShaderSrc = R"(
+flat in int vGauge;
+in vec2 vLocal;
+
+out vec4 FragColor;
+
+const float PI = 3.14159265;
+
+// Composite a layer over the accumulated premultiplied color
+vec4 over(vec4 dst, vec4 color, float coverage) {
+    float a = color.a * coverage;
+    return vec4(color.rgb * a + dst.rgb * (1.0 - a), a + dst.a * (1.0 - a));
+}
+
+// Pixel coverage of a shape from its signed distance (negative inside)
+float fill(float d, float px) {
+    return clamp(0.5 - d / px, 0.0, 1.0);
+}
+
+float segment(vec2 p, vec2 a, vec2 b) {
+    vec2 pa = p - a, ba = b - a;
+    float h = clamp(dot(pa, ba) / dot(ba, ba), 0.0, 1.0);
+    return length(pa - ba * h);
+}
+
+// Distance to the nearest of count + 1 radial ticks spaced step apart
+float ticks(vec2 p, float rel, float start, float dir, float step, float count, float inner, float outer) {
+    float i = clamp(floor(rel / step + 0.5), 0.0, count);
+    float a = start + dir * i * step;
+    vec2 t = vec2(cos(a), sin(a));
+    return segment(p, t * inner, t * outer);
+}
+
+void main()
+{
+    SdfGauge g = gauges[vGauge];
+    vec2 p = vLocal;
+    float R = g.geometry.z;
+    float d = length(p);
+
+    // Cluster units per pixel; mesh lines are 3 pixels wide
+    float px = max(length(fwidth(p)) * 0.7071, 1e-4);
+    float lineHalfWidth = 1.5 * px;
+
+    // Angle from the start of the arc in the sweep direction, wrapped so the
+    // uncovered part of the circle is split evenly before and after the arc
+    float start = g.arc.x;
+    float span = abs(g.arc.y);
+    float dir = g.arc.y < 0.0 ? -1.0 : 1.0;
+    float rel = mod((atan(p.y, p.x) - start) * dir, 2.0 * PI);
+    if (rel > 0.5 * (span + 2.0 * PI))
+        rel -= 2.0 * PI;
+
+    // Signed arc-length distance to the sector edges
+    float angular = (rel < 0.0 ? -rel : (rel > span ? rel - span : -min(rel, span - rel))) * max(d, px);
+    bool partial = (int(g.arc.w) & 2) != 0;
+
+    // Bezel and dark background, clipped to the sector as one layer so the
+    // bezel does not bleed through along the straight edges
+    vec4 color = over(vec4(0.0), g.bezelColor, fill(d - R, px));
+    color = over(color, g.faceColor, fill(d - R * g.scales.x, px));
+    if (partial)
+        color *= fill(angular, px);
+
+    // Glow band along the arc
+    float glow = max(abs(d - 0.8 * R) - 0.05 * R, angular);
+    color = over(color, g.glowColor, fill(glow, px));
+
+    // Major and minor ticks
+    if (g.ticks.x > 0.0) {
+        float majorStep = span / g.ticks.x;
+        float tick = ticks(p, rel, start, dir, majorStep, g.ticks.x, g.ticks.z * R, g.ticks.w * R);
+        if (g.ticks.y > 0.0)
+            tick = min(tick, ticks(p, rel, start, dir, majorStep / g.ticks.y, g.ticks.x * g.ticks.y, g.scales.z * R, g.scales.w * R));
+        color = over(color, g.tickColor, fill(tick - lineHalfWidth, px));
+    }
+
+    // Needle with arrow tip and counter weight
+    vec2 along = vec2(cos(g.arc.z), sin(g.arc.z));
+    vec2 across = vec2(-along.y, along.x);
+    vec2 tip = along * 0.85 * R;
+    float needle = segment(p, vec2(0.0), tip);
+    needle = min(needle, segment(p, tip, tip * 0.9 + across * 0.02 * R));
+    needle = min(needle, segment(p, tip, tip * 0.9 - across * 0.02 * R));
+    needle = min(needle, segment(p, vec2(0.0), -along * 0.05 * R));
+    color = over(color, g.needleColor, fill(needle - lineHalfWidth, px));
+
+    // Center hub
+    float hub = d - R * g.scales.y;
+    if (partial)
+        hub = max(hub, angular);
+    color = over(color, g.hubColor, fill(hub, px));
+
+    if (color.a <= 0.0)
+        discard;
+    FragColor = vec4(color.rgb / color.a, color.a);
+}
+)";
+
+static const std::vector<WarningLight> warningLights = {
+    { 1.0f, 0.0f, 0.0f, false },  // Engine warning
+    { 1.0f, 0.5f, 0.0f, false },  // Oil pressure
+    { 1.0f, 0.0f, 0.0f, false },  // Engine temperature
+    { 1.0f, 1.0f, 0.0f, false },  // Battery
+    { 1.0f, 0.5f, 0.0f, false },  // Fuel
+    { 0.0f, 0.8f, 1.0f, false },  // AC indicator
+    { 0.0f, 1.0f, 0.0f, false },  // Lights
+    { 0.0f, 1.0f, 0.0f, true },   // Left turn signal
+    { 0.0f, 1.0f, 0.0f, true },   // Right turn signal
+    { 1.0f, 0.0f, 0.0f, false },  // Parking brake
+    { 1.0f, 0.0f, 0.0f, false },  // Seatbelt
+    { 1.0f, 1.0f, 0.0f, false }   // ABS
+};
+
+static void drawRectangle(QuadBatch& batch, float x, float y, float width, float height, float r, float g, float b, float a = 1.0f) {
+    batch.add(x, y, width, height, r, g, b, a);
+}
+
+// One bar per pass in the top-left corner, scaled so the marker is one refresh period
+static void drawGpuOverlay(QuadBatch& batch, const GpuPassTimer& timer, float refreshPeriodMs) {
+    const float unitsPerMs = 12.0f;
+    const float rowHeight = 12.0f;
+    const float left = -490.0f;
+    const float top = 290.0f;
+    const float maxWidth = 480.0f;
+
+    float budgetWidth = std::min(refreshPeriodMs * unitsPerMs, maxWidth);
+    float height = timer.passCount() * rowHeight;
+    drawRectangle(batch, left - 5, top - height - 5, budgetWidth + 10, height + 10, 0.0f, 0.0f, 0.0f, 0.6f);
+
+    float barColors[][3] = {
+        {0.3f, 0.7f, 1.0f},
+        {1.0f, 0.6f, 0.2f},
+        {0.4f, 1.0f, 0.4f},
+        {1.0f, 0.3f, 0.5f}
+    };
+    for (int i = 0; i < timer.passCount(); i++) {
+        float* color = barColors[i % 4];
+        float width = std::max(1.0f, std::min(timer.recentMs(i) * unitsPerMs, maxWidth));
+        drawRectangle(batch, left, top - (i + 1) * rowHeight, width, rowHeight - 4, color[0], color[1], color[2]);
+    }
+
+    // Budget marker
+    drawRectangle(batch, left + budgetWidth, top - height - 5, 2, height + 10, 1.0f, 1.0f, 1.0f, 0.5f);
+}
+
+// Builds the digital display with mode indicator, gear, time, and temperature
+static void buildDigitalDisplay(QuadBatch& batch, int displayMode, int gear, float outsideTemp) {
+    PROFILE_ZONE("buildDigitalDisplay");
+
+    // Main display background with modern dark styling
+    drawRectangle(batch, -200, 150, 400, 100, 0.05f, 0.05f, 0.1f);
+
+    // Mode indicator with improved styling
+    const char* modes[] = { "COMFORT", "SPORT", "ECO", "INDIVIDUAL" };
+    float modeColors[][3] = { 
+        {0.0f, 0.6f, 1.0f},   // Comfort - Blue
+        {1.0f, 0.2f, 0.0f},   // Sport - Red
+        {0.0f, 1.0f, 0.2f},   // Eco - Green
+        {0.8f, 0.0f, 1.0f}    // Individual - Purple
+    };
+
+    // Mode background
+    drawRectangle(batch, -180, 180, 80, 30, 0.1f, 0.1f, 0.15f);
+    // Mode color indicator
+    drawRectangle(batch, -175, 185, 70, 20, 
+                  modeColors[displayMode][0],
+                  modeColors[displayMode][1],
+                  modeColors[displayMode][2]);
+
+    // Gear indicator with enhanced styling
+    drawRectangle(batch, -50, 180, 60, 40, 0.1f, 0.1f, 0.15f);
+    if (gear == 0) {
+        drawRectangle(batch, -40, 190, 40, 20, 0.0f, 1.0f, 0.0f); // P - Green
+    }
+    else if (gear == -1) {
+        drawRectangle(batch, -40, 190, 40, 20, 1.0f, 0.5f, 0.0f); // R - Orange
+    }
+    else if (gear > 0) {
+        drawRectangle(batch, -40, 190, 40, 20, 0.0f, 0.8f, 1.0f); // D - Blue
+    }
+
+    // Time display with blue accent
+    drawRectangle(batch, 80, 180, 100, 30, 0.1f, 0.1f, 0.15f);
+    drawRectangle(batch, 85, 185, 90, 20, 0.0f, 0.4f, 0.8f);
+
+    // Temperature and other info with conditional coloring
+    drawRectangle(batch, -150, 120, 60, 20, 
+                  outsideTemp < 5 ? 0.0f : 0.6f,
+                  outsideTemp < 5 ? 0.6f : 0.8f,
+                  outsideTemp < 5 ? 1.0f : 0.0f);
+
+    // Speed display (digital)
+    drawRectangle(batch, -50, 50, 100, 50, 0.0f, 0.0f, 0.0f, 0.8f);
+    
+    // Central info display
+    drawRectangle(batch, -100, -20, 200, 60, 0.02f, 0.02f, 0.05f);
+}
+
+ClusterRenderer::ClusterRenderer()
+    : shader(vertexShaderSrc, fragmentShaderSrc),
+      quadShader(quadVertexShaderSrc, quadFragmentShaderSrc),
+      warningShader(warningVertexShaderSrc, quadFragmentShaderSrc),
+      sdfShader((std::string(sdfGaugeBlockSrc) + sdfVertexShaderSrc).c_str(),
+                (std::string(sdfGaugeBlockSrc) + sdfFragmentShaderSrc).c_str()),
+      warningPanel(warningLights, -400.0f, -250.0f, 25.0f, 70.0f),
+      // Create gauges with enhanced styling
+      speedometer(-250.0f, -50.0f, 120.0f, GaugeType::FULL_CIRCLE),
+      tachometer(250.0f, -50.0f, 120.0f, GaugeType::FULL_CIRCLE),
+      fuelGauge(400.0f, -20.0f, 60.0f, GaugeType::QUADRANT_1),
+      tempGauge(400.0f, -80.0f, 60.0f, GaugeType::QUADRANT_4),
+      builtPath(GaugeRenderPath::CACHED_FACE),
+      seenBus(nullptr), seenVersion(0), gaugeAngles(),
+      path(GaugeRenderPath::CACHED_FACE), overlay(false), refreshPeriodMs(1000.0f / 60.0f)
+{
+    shader.bindUniformBlock("FrameBlock", FRAME_BLOCK_BINDING);
+    shader.bindUniformBlock("DrawBlock", DRAW_BLOCK_BINDING);
+    quadShader.bindUniformBlock("FrameBlock", FRAME_BLOCK_BINDING);
+    warningShader.bindUniformBlock("FrameBlock", FRAME_BLOCK_BINDING);
+    sdfShader.bindUniformBlock("FrameBlock", FRAME_BLOCK_BINDING);
+    sdfShader.bindUniformBlock("SdfBlock", SDF_BLOCK_BINDING);
+
+    // Scene nodes, in drawing order within each pass
+    const uint32_t needleInputs[4] = {
+        1u << CHANNEL_SPEED,
+        1u << CHANNEL_RPM,
+        1u << CHANNEL_FUEL,
+        (1u << CHANNEL_ENGINE_TEMP) | (1u << CHANNEL_TEMP_MIN) | (1u << CHANNEL_TEMP_MAX)
+    };
+    for (int i = 0; i < 4; i++) {
+        faceNodes[i] = scene.addNode(0);
+        needleNodes[i] = scene.addNode(needleInputs[i]);
+    }
+    displayNode = scene.addNode((1u << CHANNEL_DISPLAY_MODE) | (1u << CHANNEL_GEAR) | (1u << CHANNEL_OUTSIDE_TEMP));
+
+    clearPass = passTimer.addPass("clear");
+    speedometerPass = passTimer.addPass("speedometer");
+    tachometerPass = passTimer.addPass("tachometer");
+    fuelPass = passTimer.addPass("fuel gauge");
+    tempPass = passTimer.addPass("temperature gauge");
+    displayPass = passTimer.addPass("digital display");
+    warningPass = passTimer.addPass("warning panel");
+}
+
+void ClusterRenderer::render(const SignalBus& bus, double time, int width, int height) {
+    passTimer.beginFrame();
+    if (&bus != seenBus) {
+        // Everything is new when drawing from another bus
+        seenBus = &bus;
+        seenVersion = 0;
+    }
+    uint32_t changed = bus.takeChanges(seenVersion);
+    auto hasChanged = [changed](SignalChannel channel) { return (changed >> channel) & 1u; };
+    int displayMode = bus.get(Signals::DisplayMode);
+    scene.invalidate(changed);
+    if (path != builtPath) {
+        scene.invalidateAll();
+        builtPath = path;
+    }
+
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glLineWidth(3.0f);
+
+    FrameParams frameParams = {};
+    frameParams.resolution[0] = (float)width;
+    frameParams.resolution[1] = (float)height;
+    frameParams.viewExtent[0] = VIEW_EXTENT_X;
+    frameParams.viewExtent[1] = VIEW_EXTENT_Y;
+    frameParams.time = (float)time;
+    frameParams.mode = displayMode;
+    frameUniforms.update(frameParams);
+
+    // Enhanced background colors based on mode
+    float bgColors[][3] = { 
+        {0.01f, 0.01f, 0.03f},   // Comfort - Dark blue
+        {0.03f, 0.01f, 0.01f},   // Sport - Dark red
+        {0.01f, 0.03f, 0.01f},   // Eco - Dark green
+        {0.03f, 0.01f, 0.03f}    // Individual - Dark purple
+    };
+    passTimer.begin(clearPass);
+    glClearColor(bgColors[displayMode][0], 
+                 bgColors[displayMode][1], 
+                 bgColors[displayMode][2], 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+    passTimer.end(clearPass);
+
+    // Calculate gauge angles for the needles whose values changed
+    if (hasChanged(CHANNEL_SPEED))
+        gaugeAngles[0] = speedometer.getAngleForValue(bus.get(Signals::Speed) / 250.0f);
+    if (hasChanged(CHANNEL_RPM))
+        gaugeAngles[1] = tachometer.getAngleForValue(bus.get(Signals::Rpm) / 8000.0f);
+    if (hasChanged(CHANNEL_FUEL))
+        gaugeAngles[2] = fuelGauge.getAngleForValue(bus.get(Signals::Fuel) / 100.0f);
+    if (hasChanged(CHANNEL_ENGINE_TEMP) || hasChanged(CHANNEL_TEMP_MIN) || hasChanged(CHANNEL_TEMP_MAX)) {
+        // Temperature mapping: clamp and normalize
+        float minTemp = bus.get(Signals::TempMin);
+        float maxTemp = bus.get(Signals::TempMax);
+        float clampedTemp = std::max(minTemp, std::min(bus.get(Signals::EngineTemp), maxTemp));
+        gaugeAngles[3] = tempGauge.getAngleForValue((clampedTemp - minTemp) / (maxTemp - minTemp));
+    }
+
+    Gauge* gauges[] = { &speedometer, &tachometer, &fuelGauge, &tempGauge };
+    bool mainGauges[] = { true, true, false, false };
+    int gaugePasses[] = { speedometerPass, tachometerPass, fuelPass, tempPass };
+
+    // Rebuild the scene nodes whose inputs changed, then upload just those
+    if (path != GaugeRenderPath::SDF) {
+        for (int i = 0; i < 4; i++) {
+            // Only re-bakes after a resize or display mode change
+            if (path == GaugeRenderPath::CACHED_FACE &&
+                gauges[i]->updateFace(shader, frameUniforms, frameParams, mainGauges[i]))
+                scene.invalidateNode(faceNodes[i]);
+            if (scene.isDirty(faceNodes[i])) {
+                if (path == GaugeRenderPath::CACHED_FACE)
+                    gauges[i]->buildCachedFaceNode(scene, faceNodes[i]);
+                else
+                    gauges[i]->buildFaceNode(scene, faceNodes[i], mainGauges[i]);
+            }
+            if (scene.isDirty(needleNodes[i]))
+                gauges[i]->buildNeedleNode(scene, needleNodes[i], gaugeAngles[i], mainGauges[i]);
+        }
+    }
+    if (scene.isDirty(displayNode)) {
+        // Its rectangles live in their own batch, so they still go out in one draw
+        scene.beginNode(displayNode);
+        buildDigitalDisplay(displayBatch, displayMode, bus.get(Signals::Gear), bus.get(Signals::OutsideTemp));
+        displayBatch.upload();
+    }
+    scene.upload();
+
+    // Draw main gauges with enhanced styling, one timed pass per gauge
+    for (int i = 0; i < 4; i++) {
+        passTimer.begin(gaugePasses[i]);
+        if (path == GaugeRenderPath::SDF) {
+            sdfGauges.add(gauges[i]->sdfParams(gaugeAngles[i], mainGauges[i]));
+            sdfGauges.flush(sdfShader);
+        }
+        else {
+            scene.drawNode(shader, faceNodes[i]);
+            scene.drawNode(shader, needleNodes[i]);
+        }
+        passTimer.end(gaugePasses[i]);
+    }
+
+    // Draw digital displays and warning lights
+    passTimer.begin(displayPass);
+    displayBatch.draw(quadShader);
+    passTimer.end(displayPass);
+
+    passTimer.begin(warningPass);
+    if (hasChanged(CHANNEL_WARNINGS))
+        warningPanel.setActiveMask(bus.get(Signals::Warnings));
+    warningPanel.draw(warningShader);
+    passTimer.end(warningPass);
+
+    if (overlay) {
+        drawGpuOverlay(quadBatch, passTimer, refreshPeriodMs);
+        quadBatch.flush(quadShader);
+    }
+}
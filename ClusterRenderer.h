@@ -0,0 +1,84 @@
+#ifndef CLUSTER_RENDERER_H
+#define CLUSTER_RENDERER_H
+
+#include "Shader.h"
+#include "Gauge.h"
+#include "QuadBatch.h"
+#include "Scene.h"
+#include "UniformBlocks.h"
+#include "WarningPanel.h"
+#include "SdfGaugeRenderer.h"
+#include "GpuPassTimer.h"
+
+class SignalBus; // Forward declaration
+
+// Cluster coordinates that map to the edges of the framebuffer
+const float VIEW_EXTENT_X = 500.0f;
+const float VIEW_EXTENT_Y = 300.0f;
+
+// How the gauges are drawn
+enum class GaugeRenderPath {
+    MESH,         // Every layer re-rasterized each frame
+    CACHED_FACE,  // Static layers baked once into a texture per gauge
+    SDF           // One quad per gauge, shapes evaluated as distance fields
+};
+
+// Everything needed to draw one cluster frame: shaders, gauges, batches and
+// the per-pass GPU timers. Needs a current GL 3.3 context for its whole life.
+class ClusterRenderer {
+public:
+    ClusterRenderer();
+
+    ClusterRenderer(const ClusterRenderer&) = delete;
+    ClusterRenderer& operator=(const ClusterRenderer&) = delete;
+
+    // Draw a frame of the bus's values into the bound framebuffer, which must
+    // be width x height with the viewport already covering it. The gauges and
+    // the digital display are retained scene nodes, rebuilt and re-uploaded
+    // only after a channel they show changes.
+    void render(const SignalBus& bus, double time, int width, int height);
+
+    GaugeRenderPath renderPath() const { return path; }
+    void setRenderPath(GaugeRenderPath renderPath) { path = renderPath; }
+
+    // Per-pass GPU cost bars; the marker sits at one refresh period
+    bool overlayVisible() const { return overlay; }
+    void setOverlayVisible(bool visible) { overlay = visible; }
+    void setRefreshPeriod(float milliseconds) { refreshPeriodMs = milliseconds; }
+
+    const GpuPassTimer& gpuTimer() const { return passTimer; }
+    const Scene& retainedScene() const { return scene; }
+
+private:
+    Shader shader, quadShader, warningShader, sdfShader;
+
+    FrameUniforms frameUniforms;
+    QuadBatch quadBatch;   // Immediate: the GPU overlay
+    QuadBatch displayBatch; // Retained: the digital display
+    SdfGaugeRenderer sdfGauges;
+    WarningPanel warningPanel;
+
+    Gauge speedometer, tachometer, fuelGauge, tempGauge;
+
+    // Face and needle node per gauge, in gauge order, and the digital display,
+    // whose node only tracks when displayBatch needs rebuilding
+    Scene scene;
+    int faceNodes[4], needleNodes[4];
+    int displayNode;
+    GaugeRenderPath builtPath; // Path the gauge nodes were built for
+
+    // Render passes timed on the GPU, in overlay order
+    GpuPassTimer passTimer;
+    int clearPass, speedometerPass, tachometerPass, fuelPass, tempPass, displayPass, warningPass;
+
+    // The bus and version last drawn, and what was derived from it
+    const SignalBus* seenBus;
+    uint64_t seenVersion;
+    float gaugeAngles[4];
+
+    GaugeRenderPath path;
+    bool overlay;
+    float refreshPeriodMs;
+};
+
+#endif
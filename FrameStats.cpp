@@ -0,0 +1,200 @@
+#include "FrameStats.h"
+#include "GpuPassTimer.h"
+#include <json/json.h>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+void FrameSampleRing::push(const FrameSample& sample) {
+    uint64_t index = written.load(std::memory_order_relaxed);
+    samples[index & (Capacity - 1)] = sample;
+    written.store(index + 1, std::memory_order_release);
+}
+
+size_t FrameSampleRing::snapshot(FrameSample* out, size_t maxCount) const {
+    uint64_t end = written.load(std::memory_order_acquire);
+    uint64_t count = std::min<uint64_t>(std::min<uint64_t>(end, maxCount), Capacity);
+    uint64_t begin = end - count;
+
+    for (uint64_t i = begin; i < end; i++)
+        out[i - begin] = samples[i & (Capacity - 1)];
+
+    // Drop whatever the producer may have overwritten while we were copying
+    uint64_t after = written.load(std::memory_order_acquire);
+    uint64_t firstIntact = after > Capacity ? after - Capacity : 0;
+    if (firstIntact > begin) {
+        uint64_t torn = std::min(firstIntact - begin, count);
+        std::copy(out + torn, out + count, out);
+        count -= torn;
+    }
+    return (size_t)count;
+}
+
+FrameStats::FrameStats(double refreshRateHz)
+    : nextPending(0), haveLastSwap(false), cpuMs(0.0f), missedVsync(0), passTimer(nullptr)
+{
+    setRefreshRate(refreshRateHz);
+    for (int i = 0; i < QueryLatency; i++) {
+        glGenQueries(1, &pending[i].query);
+        pending[i].inFlight = false;
+    }
+}
+
+FrameStats::~FrameStats() {
+    for (int i = 0; i < QueryLatency; i++)
+        glDeleteQueries(1, &pending[i].query);
+}
+
+void FrameStats::setRefreshRate(double hz) {
+    refreshPeriodMs = 1000.0 / (hz > 0.0 ? hz : 60.0);
+}
+
+void FrameStats::publish(PendingFrame& frame, bool gpuValid) {
+    if (gpuValid) {
+        GLuint64 elapsedNs = 0;
+        glGetQueryObjectui64v(frame.query, GL_QUERY_RESULT, &elapsedNs);
+        frame.sample.gpuMs = (float)(elapsedNs / 1.0e6);
+    }
+    ring.push(frame.sample);
+    frame.inFlight = false;
+}
+
+void FrameStats::collect(bool wait) {
+    // Oldest first, so samples enter the ring in frame order
+    for (int i = 0; i < QueryLatency; i++) {
+        PendingFrame& frame = pending[(nextPending + i) % QueryLatency];
+        if (!frame.inFlight)
+            continue;
+
+        GLint available = 0;
+        if (!wait)
+            glGetQueryObjectiv(frame.query, GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!wait && !available)
+            break;
+        publish(frame, true);
+    }
+}
+
+void FrameStats::flush() {
+    collect(true);
+}
+
+void FrameStats::beginFrame() {
+    collect(false);
+
+    // The GPU is more than QueryLatency frames behind; give up on that result
+    PendingFrame& frame = pending[nextPending];
+    if (frame.inFlight)
+        publish(frame, false);
+
+    frameStart = Clock::now();
+    glBeginQuery(GL_TIME_ELAPSED, frame.query);
+}
+
+void FrameStats::endSubmission() {
+    glEndQuery(GL_TIME_ELAPSED);
+    cpuMs = std::chrono::duration<float, std::milli>(Clock::now() - frameStart).count();
+}
+
+void FrameStats::endFrame() {
+    Clock::time_point now = Clock::now();
+    float swapIntervalMs = haveLastSwap ? std::chrono::duration<float, std::milli>(now - lastSwap).count() : 0.0f;
+
+    // More than one and a half refresh periods means at least one vblank went by without a new frame
+    if (swapIntervalMs > 1.5 * refreshPeriodMs)
+        missedVsync++;
+
+    PendingFrame& frame = pending[nextPending];
+    frame.sample.cpuMs = cpuMs;
+    frame.sample.gpuMs = -1.0f;
+    frame.sample.swapIntervalMs = swapIntervalMs;
+    frame.inFlight = true;
+    nextPending = (nextPending + 1) % QueryLatency;
+
+    lastSwap = now;
+    haveLastSwap = true;
+}
+
+void FrameStats::skipFrame() {
+    // The gap until the next presented frame is idle time, not a missed vsync
+    haveLastSwap = false;
+}
+
+static nlohmann::json describe(std::vector<float>& values) {
+    nlohmann::json result;
+    result["count"] = values.size();
+    if (values.empty())
+        return result;
+
+    std::sort(values.begin(), values.end());
+    double sum = 0.0;
+    for (float v : values) sum += v;
+
+    // Nearest-rank percentile
+    auto percentile = [&values](double p) {
+        size_t rank = (size_t)std::ceil(p * values.size());
+        return values[std::max<size_t>(rank, 1) - 1];
+    };
+
+    result["mean"] = sum / values.size();
+    result["p50"] = percentile(0.50);
+    result["p95"] = percentile(0.95);
+    result["p99"] = percentile(0.99);
+    result["p99.9"] = percentile(0.999);
+    result["max"] = values.back();
+    return result;
+}
+
+std::string FrameStats::summaryJson() const {
+    std::vector<FrameSample> window(FrameSampleRing::Capacity);
+    window.resize(ring.snapshot(window.data(), window.size()));
+
+    std::vector<float> cpu, gpu, swap;
+    uint64_t missedInWindow = 0;
+    for (const FrameSample& s : window) {
+        cpu.push_back(s.cpuMs);
+        if (s.gpuMs >= 0.0f)
+            gpu.push_back(s.gpuMs);
+        if (s.swapIntervalMs > 0.0f) {
+            swap.push_back(s.swapIntervalMs);
+            if (s.swapIntervalMs > 1.5 * refreshPeriodMs)
+                missedInWindow++;
+        }
+    }
+
+    nlohmann::json summary;
+    summary["frames"] = ring.total();
+    summary["windowFrames"] = window.size();
+    summary["refreshPeriodMs"] = refreshPeriodMs;
+    summary["missedVsync"] = missedVsync;
+    summary["missedVsyncInWindow"] = missedInWindow;
+    summary["cpuMs"] = describe(cpu);
+    summary["gpuMs"] = describe(gpu);
+    summary["swapIntervalMs"] = describe(swap);
+
+    if (passTimer) {
+        nlohmann::json passes = nlohmann::json::object();
+        for (int i = 0; i < passTimer->passCount(); i++) {
+            nlohmann::json pass;
+            pass["count"] = passTimer->samples(i);
+            pass["mean"] = passTimer->averageMs(i);
+            pass["recent"] = passTimer->recentMs(i);
+            pass["max"] = passTimer->maxMs(i);
+            passes[passTimer->passName(i)] = pass;
+        }
+        summary["gpuPassesMs"] = passes;
+    }
+    return summary.dump(2);
+}
+
+bool FrameStats::writeJson(const char* path) const {
+    std::ofstream file(path);
+    if (!file) {
+        std::cerr << "ERROR::FRAME_STATS::FILE_NOT_WRITTEN: " << path << "\n";
+        return false;
+    }
+    file << summaryJson() << "\n";
+    return true;
+}
@@ -0,0 +1,104 @@
+#ifndef FRAME_STATS_H
+#define FRAME_STATS_H
+
+#include <glad/glad.h>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+class GpuPassTimer; // Forward declaration
+
+// Timings of one presented frame, in milliseconds. gpuMs is negative when the
+// GPU result never became available; swapIntervalMs is zero for the first
+// frame after an idle period.
+struct FrameSample {
+    float cpuMs;          // Frame start until the swap was requested
+    float gpuMs;          // GL_TIME_ELAPSED of everything submitted in the frame
+    float swapIntervalMs; // Time since the previous swap returned
+};
+
+// Single-producer ring of the most recent frames. The render thread pushes
+// without locking; a reader on any thread copies out a consistent window.
+class FrameSampleRing {
+public:
+    static const size_t Capacity = 4096; // Power of two
+
+    FrameSampleRing() : written(0) {}
+
+    void push(const FrameSample& sample);
+
+    // Copy up to maxCount of the newest samples, oldest first; returns how many
+    size_t snapshot(FrameSample* out, size_t maxCount) const;
+
+    uint64_t total() const { return written.load(std::memory_order_acquire); }
+
+private:
+    FrameSample samples[Capacity];
+    std::atomic<uint64_t> written;
+};
+
+// Collects per-frame CPU time, GPU time and swap interval. GPU times come from
+// timer queries read back a few frames later, so measuring never stalls the pipeline.
+class FrameStats {
+public:
+    explicit FrameStats(double refreshRateHz = 60.0);
+    ~FrameStats();
+
+    FrameStats(const FrameStats&) = delete;
+    FrameStats& operator=(const FrameStats&) = delete;
+
+    // Call around every presented frame:
+    // beginFrame before any GL work, endSubmission right before the swap,
+    // endFrame right after it. skipFrame marks a frame the loop did not render.
+    void beginFrame();
+    void endSubmission();
+    void endFrame();
+    void skipFrame();
+
+    // Wait for the GPU results still in flight, e.g. before a final dump
+    void flush();
+
+    void setRefreshRate(double hz);
+
+    // Include per-pass GPU costs from this timer in the summary
+    void setPassTimer(const GpuPassTimer* timer) { passTimer = timer; }
+
+    // Percentiles over the ring window, total/missed counts, as JSON text
+    std::string summaryJson() const;
+    bool writeJson(const char* path) const;
+
+    uint64_t missedVsyncCount() const { return missedVsync; }
+    uint64_t frameCount() const { return ring.total(); }
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    static const int QueryLatency = 4; // Frames a GPU result may take to arrive
+
+    struct PendingFrame {
+        GLuint query;
+        bool inFlight;
+        FrameSample sample;
+    };
+
+    void collect(bool wait);
+    void publish(PendingFrame& frame, bool gpuValid);
+
+    FrameSampleRing ring;
+    PendingFrame pending[QueryLatency];
+    int nextPending;
+
+    Clock::time_point frameStart;
+    Clock::time_point lastSwap;
+    bool haveLastSwap;
+    float cpuMs;
+
+    double refreshPeriodMs;
+    uint64_t missedVsync;
+
+    const GpuPassTimer* passTimer;
+};
+
+#endif
@@ -1,27 +1,34 @@
 #include "Gauge.h"
-#include "Shader.h"
-#include <vector>
+#include "GaugeGeometry.h"
+#include "Scene.h"
+#include "SdfGaugeRenderer.h"
+#include "UniformBlocks.h"
+#include "Profiler.h"
 #include <algorithm>
+#include <cmath>
+
+GaugeTickConfig GaugeTickConfig::defaultFor(GaugeType type) {
+    if (type == GaugeType::FULL_CIRCLE)
+        return { 10, 5 };
+    return { 6, 0 };
+}
 
 Gauge::Gauge(float xOffset, float yOffset, float radius, GaugeType type)
-    : offsetX(xOffset), offsetY(yOffset), radius(radius), gaugeType(type)
+    : Gauge(xOffset, yOffset, radius, type, GaugeTickConfig::defaultFor(type))
 {
+}
+
+Gauge::Gauge(float xOffset, float yOffset, float radius, GaugeType type, const GaugeTickConfig& ticks)
+    : offsetX(xOffset), offsetY(yOffset), radius(radius), gaugeType(type), ticks(ticks),
+      faceExtent(radius * 1.02f), bakedExtentX(0.0f), bakedExtentY(0.0f), faceDirty(true), bakedMode(-1)
+{
+    PROFILE_ZONE("Gauge::Gauge");
     calculateAngleParams();
-    setupCircle();
-    setupNeedle();
-    setupTicks();
-    setupGlow();
+    geometry = GaugeGeometryCache::acquire(gaugeType, startAngle, sweep, ticks);
 }
 
 Gauge::~Gauge() {
-    glDeleteVertexArrays(1, &circleVAO);
-    glDeleteBuffers(1, &circleVBO);
-    glDeleteVertexArrays(1, &needleVAO);
-    glDeleteBuffers(1, &needleVBO);
-    glDeleteVertexArrays(1, &ticksVAO);
-    glDeleteBuffers(1, &ticksVBO);
-    glDeleteVertexArrays(1, &glowVAO);
-    glDeleteBuffers(1, &glowVBO);
+    GaugeGeometryCache::release(geometry);
 }
 
 void Gauge::calculateAngleParams() {
@@ -58,278 +65,186 @@ float Gauge::getAngleForValue(float normalizedValue) const {
     return angleDeg * M_PI / 180.0f;
 }
 
-void Gauge::setupCircle() {
-    const int segments = 100;
-    std::vector<float> vertices;
-
-    // Center point
-    vertices.push_back(0.0f);
-    vertices.push_back(0.0f);
-
-    if (gaugeType == GaugeType::FULL_CIRCLE) {
-        // Full circle for main gauges
-        for (int i = 0; i <= segments; i++) {
-            float angle = 2.0f * M_PI * i / segments;
-            vertices.push_back(radius * cos(angle));
-            vertices.push_back(radius * sin(angle));
-        }
-    } else {
-        // Arc for partial gauges
-        int arcSegments = (int)(segments * (sweep / 360.0f));
-        for (int i = 0; i <= arcSegments; i++) {
-            float angleDeg = startAngle + (sweep * i / arcSegments);
-            float angle = angleDeg * M_PI / 180.0f;
-            vertices.push_back(radius * cos(angle));
-            vertices.push_back(radius * sin(angle));
-        }
-    }
+void Gauge::buildFaceNode(Scene& scene, int node, bool isMainGauge) {
+    scene.beginNode(node);
+    queueFace(scene, offsetX, offsetY, isMainGauge);
+}
 
-    glGenVertexArrays(1, &circleVAO);
-    glGenBuffers(1, &circleVBO);
+void Gauge::buildCachedFaceNode(Scene& scene, int node) {
+    scene.beginNode(node);
+    queueCachedFace(scene);
+}
 
-    glBindVertexArray(circleVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, circleVBO);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
+void Gauge::buildNeedleNode(Scene& scene, int node, float needleRotationRadians, bool isMainGauge) {
+    scene.beginNode(node);
+    queueNeedleAndHub(scene, needleRotationRadians, isMainGauge);
 }
 
-void Gauge::setupNeedle() {
-    float needleLength = radius * 0.85f;
-    float needleWidth = radius * 0.02f;
-    float hubRadius = radius * 0.05f;
-    
-    std::vector<float> needleVertices;
-    
-    // Needle line (main part)
-    needleVertices.push_back(0.0f);
-    needleVertices.push_back(0.0f);
-    needleVertices.push_back(needleLength);
-    needleVertices.push_back(0.0f);
-    
-    // Needle triangle tip
-    needleVertices.push_back(needleLength);
-    needleVertices.push_back(0.0f);
-    needleVertices.push_back(needleLength * 0.9f);
-    needleVertices.push_back(needleWidth);
-    
-    needleVertices.push_back(needleLength);
-    needleVertices.push_back(0.0f);
-    needleVertices.push_back(needleLength * 0.9f);
-    needleVertices.push_back(-needleWidth);
-    
-    // Counter weight
-    needleVertices.push_back(0.0f);
-    needleVertices.push_back(0.0f);
-    needleVertices.push_back(-hubRadius);
-    needleVertices.push_back(0.0f);
-
-    glGenVertexArrays(1, &needleVAO);
-    glGenBuffers(1, &needleVBO);
-
-    glBindVertexArray(needleVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, needleVBO);
-    glBufferData(GL_ARRAY_BUFFER, needleVertices.size() * sizeof(float), needleVertices.data(), GL_STATIC_DRAW);
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
+bool Gauge::updateFace(const Shader& shader, FrameUniforms& frameUniforms, const FrameParams& frame, bool isMainGauge) {
+    // Match the texture's texel density to the screen's so lines keep their
+    // width, and keep the size even so texels land on whole screen pixels
+    float pixelsPerUnitX = frame.resolution[0] / (2.0f * frame.viewExtent[0]);
+    float pixelsPerUnitY = frame.resolution[1] / (2.0f * frame.viewExtent[1]);
+    int width = std::max(2, 2 * (int)std::ceil(faceExtent * pixelsPerUnitX));
+    int height = std::max(2, 2 * (int)std::ceil(faceExtent * pixelsPerUnitY));
+
+    if (!faceDirty && face.valid() && width == face.width() && height == face.height() && frame.mode == bakedMode)
+        return false;
+
+    PROFILE_ZONE("Gauge::updateFace");
+    GLint previousFBO = 0;
+    GLint previousViewport[4];
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previousFBO);
+    glGetIntegerv(GL_VIEWPORT, previousViewport);
+
+    face.resize(width, height);
+    face.bind();
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+
+    // Gauge-local space: the face texture spans [-bakedExtent, bakedExtent]
+    bakedExtentX = width / (2.0f * pixelsPerUnitX);
+    bakedExtentY = height / (2.0f * pixelsPerUnitY);
+    FrameParams bakeFrame = frame;
+    bakeFrame.viewExtent[0] = bakedExtentX;
+    bakeFrame.viewExtent[1] = bakedExtentY;
+    frameUniforms.update(bakeFrame);
+
+    // Accumulate alpha so the texture holds premultiplied color
+    glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+
+    DrawQueue bakeQueue(8);
+    queueFace(bakeQueue, 0.0f, 0.0f, isMainGauge);
+    bakeQueue.flush(shader);
+
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    frameUniforms.update(frame);
+    glBindFramebuffer(GL_FRAMEBUFFER, (GLuint)previousFBO);
+    glViewport(previousViewport[0], previousViewport[1], previousViewport[2], previousViewport[3]);
+
+    faceDirty = false;
+    bakedMode = frame.mode;
+    return true;
 }
 
-void Gauge::setupTicks() {
-    std::vector<float> tickVertices;
-    
-    if (gaugeType == GaugeType::FULL_CIRCLE) {
-        // Main gauge ticks (speed/RPM) - clockwise (mirrored)
-        const int majorTicks = 10;
-        const int minorTicksPerMajor = 5;
-        const int totalMinorTicks = majorTicks * minorTicksPerMajor;
-
-        // Major ticks - mirrored for clockwise
-        for (int i = 0; i <= majorTicks; i++) {
-            float angleDeg = startAngle - (sweep * i / majorTicks);
-            float angle = angleDeg * M_PI / 180.0f;
-
-            float innerRadius = radius * 0.85f;
-            float outerRadius = radius * 0.95f;
-
-            float cosA = cos(angle);
-            float sinA = sin(angle);
-
-            tickVertices.push_back(innerRadius * cosA);
-            tickVertices.push_back(innerRadius * sinA);
-            tickVertices.push_back(outerRadius * cosA);
-            tickVertices.push_back(outerRadius * sinA);
-        }
+static void setColor(float* dst, float r, float g, float b, float a = 1.0f) {
+    dst[0] = r; dst[1] = g; dst[2] = b; dst[3] = a;
+}
 
-        // Minor ticks - mirrored for clockwise
-        for (int i = 0; i <= totalMinorTicks; i++) {
-            float angleDeg = startAngle - (sweep * i / totalMinorTicks);
-            
-            // Skip if it's a major tick position
-            bool isMajorTick = (i % minorTicksPerMajor == 0);
-            
-            if (!isMajorTick) {
-                float angle = angleDeg * M_PI / 180.0f;
-                float innerRadius = radius * 0.88f;
-                float outerRadius = radius * 0.92f;
-
-                float cosA = cos(angle);
-                float sinA = sin(angle);
-
-                tickVertices.push_back(innerRadius * cosA);
-                tickVertices.push_back(innerRadius * sinA);
-                tickVertices.push_back(outerRadius * cosA);
-                tickVertices.push_back(outerRadius * sinA);
-            }
-        }
+SdfGaugeParams Gauge::sdfParams(float needleRotationRadians, bool isMainGauge) const {
+    SdfGaugeParams p = {};
+    bool fullCircle = (gaugeType == GaugeType::FULL_CIRCLE);
+    float toRadians = (float)M_PI / 180.0f;
+
+    p.geometry[0] = offsetX;
+    p.geometry[1] = offsetY;
+    p.geometry[2] = radius;
+    p.geometry[3] = faceExtent;
+
+    // Main gauges sweep clockwise, partial gauges counter-clockwise
+    p.arc[0] = startAngle * toRadians;
+    p.arc[1] = (fullCircle ? -sweep : sweep) * toRadians;
+    p.arc[2] = needleRotationRadians;
+    p.arc[3] = (isMainGauge ? 1.0f : 0.0f) + (fullCircle ? 0.0f : 2.0f);
+
+    p.ticks[0] = (float)ticks.majorTicks;
+    p.ticks[1] = fullCircle ? (float)ticks.minorTicksPerMajor : 0.0f;
+    p.ticks[2] = fullCircle ? 0.85f : 0.80f;
+    p.ticks[3] = 0.95f;
+
+    p.scales[0] = isMainGauge ? 0.92f : 0.85f;
+    p.scales[1] = isMainGauge ? 0.06f : 0.08f;
+    p.scales[2] = 0.88f;
+    p.scales[3] = 0.92f;
+
+    // Layers the mesh path does not draw for this gauge get zero alpha
+    if (isMainGauge) {
+        setColor(p.bezelColor, 0.8f, 0.8f, 0.9f);
+        setColor(p.faceColor, 0.02f, 0.02f, 0.08f);
+        setColor(p.glowColor, 0.0f, 0.4f, 1.0f, 0.6f);
+        setColor(p.tickColor, 0.7f, 0.8f, 1.0f);
+        setColor(p.needleColor, 0.9f, 0.9f, 1.0f);
+        setColor(p.hubColor, 0.2f, 0.3f, 0.4f);
     } else {
-        // Smaller gauge ticks (fuel/temp) - keep original behavior
-        const int totalTicks = 6;
-        
-        for (int i = 0; i <= totalTicks; i++) {
-            float angleDeg = startAngle + (sweep * i / totalTicks);
-            float angle = angleDeg * M_PI / 180.0f;
-
-            float innerRadius = radius * 0.80f;
-            float outerRadius = radius * 0.95f;
-
-            float cosA = cos(angle);
-            float sinA = sin(angle);
-
-            tickVertices.push_back(innerRadius * cosA);
-            tickVertices.push_back(innerRadius * sinA);
-            tickVertices.push_back(outerRadius * cosA);
-            tickVertices.push_back(outerRadius * sinA);
-        }
+        float ring = fullCircle ? 0.0f : 1.0f;
+        setColor(p.bezelColor, 0.6f, 0.6f, 0.7f, ring);
+        setColor(p.faceColor, 0.02f, 0.02f, 0.08f, ring);
+        setColor(p.glowColor, 0.0f, 0.0f, 0.0f, 0.0f);
+        setColor(p.tickColor, 0.6f, 0.7f, 0.8f);
+        setColor(p.needleColor, 1.0f, 0.3f, 0.0f);
+        setColor(p.hubColor, 0.15f, 0.2f, 0.25f);
     }
 
-    glGenVertexArrays(1, &ticksVAO);
-    glGenBuffers(1, &ticksVBO);
-
-    glBindVertexArray(ticksVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, ticksVBO);
-    glBufferData(GL_ARRAY_BUFFER, tickVertices.size() * sizeof(float), tickVertices.data(), GL_STATIC_DRAW);
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-
-    tickCount = tickVertices.size() / 2;
-}
-
-void Gauge::setupGlow() {
-    std::vector<float> glowVertices;
-    const int segments = 50;
-    
-    if (gaugeType == GaugeType::FULL_CIRCLE) {
-        // Create glow arc for active portion of the gauge - mirrored for clockwise
-        for (int i = 0; i <= segments; i++) {
-            float angleDeg = startAngle - (sweep * i / segments);
-            float angle = angleDeg * M_PI / 180.0f;
-            
-            float innerRadius = radius * 0.75f;
-            float outerRadius = radius * 0.85f;
-            
-            float cosA = cos(angle);
-            float sinA = sin(angle);
-            
-            // Inner vertex
-            glowVertices.push_back(innerRadius * cosA);
-            glowVertices.push_back(innerRadius * sinA);
-            
-            // Outer vertex
-            glowVertices.push_back(outerRadius * cosA);
-            glowVertices.push_back(outerRadius * sinA);
-        }
-    }
-    
-    glGenVertexArrays(1, &glowVAO);
-    glGenBuffers(1, &glowVBO);
-
-    glBindVertexArray(glowVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, glowVBO);
-    glBufferData(GL_ARRAY_BUFFER, glowVertices.size() * sizeof(float), glowVertices.data(), GL_STATIC_DRAW);
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-    
-    glowVertexCount = glowVertices.size() / 2;
+    return p;
 }
 
-void Gauge::draw(const Shader& shader, float needleRotationRadians, bool isMainGauge) {
-    shader.use();
-    shader.setVec2("scale", 1.0f, 1.0f);
-    shader.setVec2("offset", offsetX, offsetY);
-    shader.setFloat("rotation", 0.0f);
+template <class Sink>
+void Gauge::queueFace(Sink& queue, float x, float y, bool isMainGauge) {
+    const GaugeGeometry& g = *geometry;
 
     if (isMainGauge) {
         // Draw outer bezel (chrome/silver effect)
-        shader.setVec3("color", 0.8f, 0.8f, 0.9f);
-        shader.setFloat("alpha", 1.0f);
-        glBindVertexArray(circleVAO);
-        glDrawArrays(GL_TRIANGLE_FAN, 0, 102);
+        queue.push(g.circleVAO, GL_TRIANGLE_FAN, 0, g.circleVertexCount,
+                   makeDrawParams(x, y, radius, radius, 0.0f, 0.8f, 0.8f, 0.9f));
 
         // Draw dark background
-        shader.setVec2("scale", 0.92f, 0.92f);
-        shader.setVec3("color", 0.02f, 0.02f, 0.08f);
-        glDrawArrays(GL_TRIANGLE_FAN, 0, 102);
-        
+        queue.push(g.circleVAO, GL_TRIANGLE_FAN, 0, g.circleVertexCount,
+                   makeDrawParams(x, y, radius * 0.92f, radius * 0.92f, 0.0f, 0.02f, 0.02f, 0.08f));
+
         // Draw glow effect for active area
-        shader.setVec2("scale", 1.0f, 1.0f);
-        shader.setVec3("color", 0.0f, 0.4f, 1.0f); // Blue glow
-        shader.setFloat("alpha", 0.6f);
-        glBindVertexArray(glowVAO);
-        glDrawArrays(GL_TRIANGLE_STRIP, 0, glowVertexCount);
-        
-        // Draw tick marks
-        shader.setFloat("alpha", 1.0f);
-        shader.setVec3("color", 0.7f, 0.8f, 1.0f);
-        glBindVertexArray(ticksVAO);
-        glDrawArrays(GL_LINES, 0, tickCount);
+        queue.push(g.glowVAO, GL_TRIANGLE_STRIP, 0, g.glowVertexCount,
+                   makeDrawParams(x, y, radius, radius, 0.0f, 0.0f, 0.4f, 1.0f, 0.6f)); // Blue glow
 
-        // Draw needle
-        shader.setFloat("rotation", needleRotationRadians);
-        shader.setVec3("color", 0.9f, 0.9f, 1.0f); // Bright white/blue
-        glBindVertexArray(needleVAO);
-        glDrawArrays(GL_LINES, 0, 8);
+        // Draw tick marks
+        queue.push(g.ticksVAO, GL_LINES, 0, g.tickVertexCount,
+                   makeDrawParams(x, y, radius, radius, 0.0f, 0.7f, 0.8f, 1.0f));
 
-        // Draw center hub
-        shader.setFloat("rotation", 0.0f);
-        shader.setVec2("scale", 0.06f, 0.06f);
-        shader.setVec3("color", 0.2f, 0.3f, 0.4f);
-        glBindVertexArray(circleVAO);
-        glDrawArrays(GL_TRIANGLE_FAN, 0, 102);
-        
     } else {
         // Smaller gauges (fuel/temp)
-        // Draw outer ring
-        shader.setVec3("color", 0.6f, 0.6f, 0.7f);
-        shader.setFloat("alpha", 1.0f);
-        glBindVertexArray(circleVAO);
-        
         if (gaugeType == GaugeType::QUADRANT_1 || gaugeType == GaugeType::QUADRANT_4) {
-            int arcVertices = (int)(102 * (sweep / 360.0f)) + 2;
-            glDrawArrays(GL_TRIANGLE_FAN, 0, arcVertices);
-            
+            // Draw outer ring
+            queue.push(g.circleVAO, GL_TRIANGLE_FAN, 0, g.circleVertexCount,
+                       makeDrawParams(x, y, radius, radius, 0.0f, 0.6f, 0.6f, 0.7f));
+
             // Draw background
-            shader.setVec2("scale", 0.85f, 0.85f);
-            shader.setVec3("color", 0.02f, 0.02f, 0.08f);
-            glDrawArrays(GL_TRIANGLE_FAN, 0, arcVertices);
+            queue.push(g.circleVAO, GL_TRIANGLE_FAN, 0, g.circleVertexCount,
+                       makeDrawParams(x, y, radius * 0.85f, radius * 0.85f, 0.0f, 0.02f, 0.02f, 0.08f));
         }
 
         // Draw tick marks
-        shader.setVec2("scale", 1.0f, 1.0f);
-        shader.setVec3("color", 0.6f, 0.7f, 0.8f);
-        glBindVertexArray(ticksVAO);
-        glDrawArrays(GL_LINES, 0, tickCount);
+        queue.push(g.ticksVAO, GL_LINES, 0, g.tickVertexCount,
+                   makeDrawParams(x, y, radius, radius, 0.0f, 0.6f, 0.7f, 0.8f));
+    }
+}
 
+template <class Sink>
+void Gauge::queueCachedFace(Sink& queue) {
+    const GaugeGeometry& g = *geometry;
+    DrawParams params = makeDrawParams(offsetX, offsetY, bakedExtentX, bakedExtentY, 0.0f, 1.0f, 1.0f, 1.0f);
+    params.textured = 1.0f;
+    queue.push(g.quadVAO, GL_TRIANGLE_FAN, 0, g.quadVertexCount, params, face.texture());
+}
+
+template <class Sink>
+void Gauge::queueNeedleAndHub(Sink& queue, float needleRotationRadians, bool isMainGauge) {
+    const GaugeGeometry& g = *geometry;
+
+    if (isMainGauge) {
         // Draw needle
-        shader.setFloat("rotation", needleRotationRadians);
-        shader.setVec3("color", 1.0f, 0.3f, 0.0f); // Orange/red for smaller gauges
-        glBindVertexArray(needleVAO);
-        glDrawArrays(GL_LINES, 0, 8);
+        queue.push(g.needleVAO, GL_LINES, 0, g.needleVertexCount,
+                   makeDrawParams(offsetX, offsetY, radius, radius, needleRotationRadians, 0.9f, 0.9f, 1.0f)); // Bright white/blue
 
         // Draw center hub
-        shader.setFloat("rotation", 0.0f);
-        shader.setVec2("scale", 0.08f, 0.08f);
-        shader.setVec3("color", 0.15f, 0.2f, 0.25f);
-        glBindVertexArray(circleVAO);
-        glDrawArrays(GL_TRIANGLE_FAN, 0, 102);
+        queue.push(g.circleVAO, GL_TRIANGLE_FAN, 0, g.circleVertexCount,
+                   makeDrawParams(offsetX, offsetY, radius * 0.06f, radius * 0.06f, 0.0f, 0.2f, 0.3f, 0.4f));
+
+    } else {
+        // Draw needle
+        queue.push(g.needleVAO, GL_LINES, 0, g.needleVertexCount,
+                   makeDrawParams(offsetX, offsetY, radius, radius, needleRotationRadians, 1.0f, 0.3f, 0.0f)); // Orange/red for smaller gauges
+
+        // Draw center hub
+        queue.push(g.circleVAO, GL_TRIANGLE_FAN, 0, g.circleVertexCount,
+                   makeDrawParams(offsetX, offsetY, radius * 0.08f, radius * 0.08f, 0.0f, 0.15f, 0.2f, 0.25f));
     }
-}
\ No newline at end of file
+}
@@ -4,12 +4,19 @@
 #include <glad/glad.h>
 #include <cmath>
 
+#include "RenderTarget.h"
+
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
 
 
-class Shader; // Forward declaration
+class FrameUniforms; // Forward declaration
+class Scene;
+class Shader;
+struct FrameParams;
+struct GaugeGeometry;
+struct SdfGaugeParams;
 
 enum class GaugeType {
     FULL_CIRCLE,    // 270 sweep from -135 to +135
@@ -17,37 +24,68 @@ enum class GaugeType {
     QUADRANT_4      // 90 sweep from 270 to 360 (temp)
 };
 
+// Tick layout of a gauge face. minorTicksPerMajor of 0 draws major ticks only.
+struct GaugeTickConfig {
+    int majorTicks;
+    int minorTicksPerMajor;
+
+    static GaugeTickConfig defaultFor(GaugeType type);
+};
+
 class Gauge {
 public:
     Gauge(float xOffset, float yOffset, float radius, GaugeType type = GaugeType::FULL_CIRCLE);
+    Gauge(float xOffset, float yOffset, float radius, GaugeType type, const GaugeTickConfig& ticks);
     ~Gauge();
 
-    void draw(const Shader& shader, float needleRotationRadians, bool isMainGauge = false);
+    Gauge(const Gauge&) = delete;
+    Gauge& operator=(const Gauge&) = delete;
+
+    // Cached-face path: the static layers (bezel, background, glow, ticks) are
+    // baked into a texture, so a frame only composites one quad plus needle and hub.
+    // updateFace re-bakes when the framebuffer size or display mode changed, or
+    // after invalidateFace; it leaves the FrameBlock, framebuffer and viewport as it found them.
+    // Returns true when it re-baked, which can replace the face texture.
+    bool updateFace(const Shader& shader, FrameUniforms& frameUniforms, const FrameParams& frame, bool isMainGauge = false);
+    void invalidateFace() { faceDirty = true; }
+
+    // Retained path: rebuild one scene node with the static face layers, the
+    // baked face quad (after updateFace), or the needle and hub
+    void buildFaceNode(Scene& scene, int node, bool isMainGauge = false);
+    void buildCachedFaceNode(Scene& scene, int node);
+    void buildNeedleNode(Scene& scene, int node, float needleRotationRadians, bool isMainGauge = false);
+
+    // SDF path: everything the distance-field shader needs to draw this gauge
+    // as one quad, with the same colors and proportions as the mesh path
+    SdfGaugeParams sdfParams(float needleRotationRadians, bool isMainGauge = false) const;
 
     // Get the correct angle for a value (0.0 to 1.0 normalized)
     float getAngleForValue(float normalizedValue) const;
 
 private:
-    void setupCircle();
-    void setupNeedle();
-    void setupTicks();
-    void setupGlow();
+    // Push into a DrawQueue or a Scene node
+    template <class Sink> void queueFace(Sink& queue, float x, float y, bool isMainGauge);
+    template <class Sink> void queueCachedFace(Sink& queue);
+    template <class Sink> void queueNeedleAndHub(Sink& queue, float needleRotationRadians, bool isMainGauge);
 
-    // OpenGL objects
-    GLuint circleVAO, circleVBO;
-    GLuint needleVAO, needleVBO;
-    GLuint ticksVAO, ticksVBO;
-    GLuint glowVAO, glowVBO;
+    // Unit-radius meshes shared with every gauge of the same type and ticks
+    const GaugeGeometry* geometry;
 
     // Gauge properties
     float offsetX, offsetY, radius;
     GaugeType gaugeType;
-    int tickCount;
-    int glowVertexCount;
+    GaugeTickConfig ticks;
 
     // Angle parameters based on gauge type
     float startAngle, endAngle, sweep;
 
+    // Baked static layers and what they were baked for
+    RenderTarget face;
+    float faceExtent;               // Margin around the radius covered by the face
+    float bakedExtentX, bakedExtentY; // Exact cluster-space half size of the texture
+    bool faceDirty;
+    int bakedMode;
+
     void calculateAngleParams();
 };
 
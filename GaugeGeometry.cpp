@@ -0,0 +1,256 @@
+#include "GaugeGeometry.h"
+#include <algorithm>
+#include <map>
+#include <tuple>
+
+std::vector<float> GaugeTessellator::circle(GaugeType type, float startAngle, float sweep) {
+    const int segments = 100;
+    std::vector<float> vertices;
+
+    // Center point
+    vertices.push_back(0.0f);
+    vertices.push_back(0.0f);
+
+    if (type == GaugeType::FULL_CIRCLE) {
+        // Full circle for main gauges
+        for (int i = 0; i <= segments; i++) {
+            float angle = 2.0f * M_PI * i / segments;
+            vertices.push_back(cos(angle));
+            vertices.push_back(sin(angle));
+        }
+    } else {
+        // Arc for partial gauges
+        int arcSegments = (int)(segments * (sweep / 360.0f));
+        for (int i = 0; i <= arcSegments; i++) {
+            float angleDeg = startAngle + (sweep * i / arcSegments);
+            float angle = angleDeg * M_PI / 180.0f;
+            vertices.push_back(cos(angle));
+            vertices.push_back(sin(angle));
+        }
+    }
+
+    return vertices;
+}
+
+std::vector<float> GaugeTessellator::needle() {
+    float needleLength = 0.85f;
+    float needleWidth = 0.02f;
+    float hubRadius = 0.05f;
+
+    std::vector<float> needleVertices;
+
+    // Needle line (main part)
+    needleVertices.push_back(0.0f);
+    needleVertices.push_back(0.0f);
+    needleVertices.push_back(needleLength);
+    needleVertices.push_back(0.0f);
+
+    // Needle triangle tip
+    needleVertices.push_back(needleLength);
+    needleVertices.push_back(0.0f);
+    needleVertices.push_back(needleLength * 0.9f);
+    needleVertices.push_back(needleWidth);
+
+    needleVertices.push_back(needleLength);
+    needleVertices.push_back(0.0f);
+    needleVertices.push_back(needleLength * 0.9f);
+    needleVertices.push_back(-needleWidth);
+
+    // Counter weight
+    needleVertices.push_back(0.0f);
+    needleVertices.push_back(0.0f);
+    needleVertices.push_back(-hubRadius);
+    needleVertices.push_back(0.0f);
+
+    return needleVertices;
+}
+
+std::vector<float> GaugeTessellator::ticks(GaugeType type, float startAngle, float sweep, const GaugeTickConfig& config) {
+    std::vector<float> tickVertices;
+
+    // No major ticks means no tick mesh; the spacing below divides by the count
+    if (config.majorTicks < 1)
+        return tickVertices;
+
+    if (type == GaugeType::FULL_CIRCLE) {
+        // Main gauge ticks (speed/RPM) - clockwise (mirrored)
+        const int majorTicks = config.majorTicks;
+        const int minorTicksPerMajor = config.minorTicksPerMajor;
+        const int totalMinorTicks = majorTicks * minorTicksPerMajor;
+
+        // Major ticks - mirrored for clockwise
+        for (int i = 0; i <= majorTicks; i++) {
+            float angleDeg = startAngle - (sweep * i / majorTicks);
+            float angle = angleDeg * M_PI / 180.0f;
+
+            float innerRadius = 0.85f;
+            float outerRadius = 0.95f;
+
+            float cosA = cos(angle);
+            float sinA = sin(angle);
+
+            tickVertices.push_back(innerRadius * cosA);
+            tickVertices.push_back(innerRadius * sinA);
+            tickVertices.push_back(outerRadius * cosA);
+            tickVertices.push_back(outerRadius * sinA);
+        }
+
+        // Minor ticks - mirrored for clockwise
+        for (int i = 0; minorTicksPerMajor > 0 && i <= totalMinorTicks; i++) {
+            float angleDeg = startAngle - (sweep * i / totalMinorTicks);
+
+            // Skip if it's a major tick position
+            bool isMajorTick = (i % minorTicksPerMajor == 0);
+
+            if (!isMajorTick) {
+                float angle = angleDeg * M_PI / 180.0f;
+                float innerRadius = 0.88f;
+                float outerRadius = 0.92f;
+
+                float cosA = cos(angle);
+                float sinA = sin(angle);
+
+                tickVertices.push_back(innerRadius * cosA);
+                tickVertices.push_back(innerRadius * sinA);
+                tickVertices.push_back(outerRadius * cosA);
+                tickVertices.push_back(outerRadius * sinA);
+            }
+        }
+    } else {
+        // Smaller gauge ticks (fuel/temp) - keep original behavior
+        const int totalTicks = config.majorTicks;
+
+        for (int i = 0; i <= totalTicks; i++) {
+            float angleDeg = startAngle + (sweep * i / totalTicks);
+            float angle = angleDeg * M_PI / 180.0f;
+
+            float innerRadius = 0.80f;
+            float outerRadius = 0.95f;
+
+            float cosA = cos(angle);
+            float sinA = sin(angle);
+
+            tickVertices.push_back(innerRadius * cosA);
+            tickVertices.push_back(innerRadius * sinA);
+            tickVertices.push_back(outerRadius * cosA);
+            tickVertices.push_back(outerRadius * sinA);
+        }
+    }
+
+    return tickVertices;
+}
+
+std::vector<float> GaugeTessellator::glow(GaugeType type, float startAngle, float sweep) {
+    std::vector<float> glowVertices;
+    const int segments = 50;
+
+    if (type == GaugeType::FULL_CIRCLE) {
+        // Create glow arc for active portion of the gauge - mirrored for clockwise
+        for (int i = 0; i <= segments; i++) {
+            float angleDeg = startAngle - (sweep * i / segments);
+            float angle = angleDeg * M_PI / 180.0f;
+
+            float innerRadius = 0.75f;
+            float outerRadius = 0.85f;
+
+            float cosA = cos(angle);
+            float sinA = sin(angle);
+
+            // Inner vertex
+            glowVertices.push_back(innerRadius * cosA);
+            glowVertices.push_back(innerRadius * sinA);
+
+            // Outer vertex
+            glowVertices.push_back(outerRadius * cosA);
+            glowVertices.push_back(outerRadius * sinA);
+        }
+    }
+
+    return glowVertices;
+}
+
+std::vector<float> GaugeTessellator::quad() {
+    return {
+        -1.0f, -1.0f,
+         1.0f, -1.0f,
+         1.0f,  1.0f,
+        -1.0f,  1.0f
+    };
+}
+
+namespace {
+    struct CacheEntry {
+        GaugeGeometry geometry;
+        int refCount;
+    };
+
+    typedef std::tuple<int, int, int> CacheKey; // Gauge type, major ticks, minor ticks per major
+
+    std::map<CacheKey, CacheEntry>& cache() {
+        static std::map<CacheKey, CacheEntry> entries;
+        return entries;
+    }
+
+    void upload(const std::vector<float>& vertices, GLuint& vao, GLuint& vbo, int& vertexCount) {
+        glGenVertexArrays(1, &vao);
+        glGenBuffers(1, &vbo);
+
+        glBindVertexArray(vao);
+        glBindBuffer(GL_ARRAY_BUFFER, vbo);
+        glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
+        glEnableVertexAttribArray(0);
+
+        vertexCount = (int)(vertices.size() / 2);
+    }
+
+    void destroy(GaugeGeometry& g) {
+        glDeleteVertexArrays(1, &g.circleVAO);
+        glDeleteBuffers(1, &g.circleVBO);
+        glDeleteVertexArrays(1, &g.needleVAO);
+        glDeleteBuffers(1, &g.needleVBO);
+        glDeleteVertexArrays(1, &g.ticksVAO);
+        glDeleteBuffers(1, &g.ticksVBO);
+        glDeleteVertexArrays(1, &g.glowVAO);
+        glDeleteBuffers(1, &g.glowVBO);
+        glDeleteVertexArrays(1, &g.quadVAO);
+        glDeleteBuffers(1, &g.quadVBO);
+    }
+}
+
+const GaugeGeometry* GaugeGeometryCache::acquire(GaugeType type, float startAngle, float sweep, const GaugeTickConfig& ticks) {
+    // Every layout without major ticks draws nothing, so they share one entry
+    int majorTicks = std::max(ticks.majorTicks, 0);
+    int minorTicksPerMajor = majorTicks > 0 ? std::max(ticks.minorTicksPerMajor, 0) : 0;
+    CacheKey key((int)type, majorTicks, minorTicksPerMajor);
+
+    auto it = cache().find(key);
+    if (it != cache().end()) {
+        it->second.refCount++;
+        return &it->second.geometry;
+    }
+
+    CacheEntry& entry = cache()[key];
+    entry.refCount = 1;
+
+    GaugeGeometry& g = entry.geometry;
+    upload(GaugeTessellator::circle(type, startAngle, sweep), g.circleVAO, g.circleVBO, g.circleVertexCount);
+    upload(GaugeTessellator::needle(), g.needleVAO, g.needleVBO, g.needleVertexCount);
+    upload(GaugeTessellator::ticks(type, startAngle, sweep, { majorTicks, minorTicksPerMajor }), g.ticksVAO, g.ticksVBO, g.tickVertexCount);
+    upload(GaugeTessellator::glow(type, startAngle, sweep), g.glowVAO, g.glowVBO, g.glowVertexCount);
+    upload(GaugeTessellator::quad(), g.quadVAO, g.quadVBO, g.quadVertexCount);
+
+    return &g;
+}
+
+void GaugeGeometryCache::release(const GaugeGeometry* geometry) {
+    for (auto it = cache().begin(); it != cache().end(); ++it) {
+        if (&it->second.geometry == geometry) {
+            if (--it->second.refCount == 0) {
+                destroy(it->second.geometry);
+                cache().erase(it);
+            }
+            return;
+        }
+    }
+}
@@ -0,0 +1,40 @@
+#ifndef GAUGE_GEOMETRY_H
+#define GAUGE_GEOMETRY_H
+
+#include <glad/glad.h>
+#include <vector>
+
+#include "Gauge.h"
+
+// Unit-radius meshes for one gauge type and tick layout. The gauge radius is
+// applied through the draw transform, so every gauge of the same kind shares them.
+struct GaugeGeometry {
+    GLuint circleVAO, circleVBO;
+    GLuint needleVAO, needleVBO;
+    GLuint ticksVAO, ticksVBO;
+    GLuint glowVAO, glowVBO;
+    GLuint quadVAO, quadVBO;   // [-1, 1] square for compositing a baked face
+
+    int circleVertexCount;
+    int needleVertexCount;
+    int tickVertexCount;
+    int glowVertexCount;
+    int quadVertexCount;
+};
+
+// CPU tessellators, unit radius, interleaved x/y
+namespace GaugeTessellator {
+    std::vector<float> circle(GaugeType type, float startAngle, float sweep);
+    std::vector<float> needle();
+    std::vector<float> ticks(GaugeType type, float startAngle, float sweep, const GaugeTickConfig& config);
+    std::vector<float> glow(GaugeType type, float startAngle, float sweep);
+    std::vector<float> quad();
+}
+
+// Reference-counted cache of uploaded gauge meshes keyed by type and tick layout
+namespace GaugeGeometryCache {
+    const GaugeGeometry* acquire(GaugeType type, float startAngle, float sweep, const GaugeTickConfig& ticks);
+    void release(const GaugeGeometry* geometry);
+}
+
+#endif
@@ -0,0 +1,80 @@
+#include "GpuPassTimer.h"
+
+GpuPassTimer::GpuPassTimer() : count(0), current(0) {
+    for (int i = 0; i < Latency; i++) {
+        glGenQueries(MaxPasses * 2, &frames[i].queries[0][0]);
+        frames[i].usedPasses = 0;
+    }
+}
+
+GpuPassTimer::~GpuPassTimer() {
+    for (int i = 0; i < Latency; i++)
+        glDeleteQueries(MaxPasses * 2, &frames[i].queries[0][0]);
+}
+
+int GpuPassTimer::addPass(const char* name) {
+    if (count >= MaxPasses)
+        return -1;
+    passes[count] = { name, 0.0f, 0.0f, 0.0, 0 };
+    return count++;
+}
+
+float GpuPassTimer::averageMs(int pass) const {
+    const Pass& p = passes[pass];
+    return p.samples > 0 ? (float)(p.totalMs / p.samples) : 0.0f;
+}
+
+bool GpuPassTimer::resolve(FrameQueries& frame) {
+    for (int i = 0; i < count; i++) {
+        if (!(frame.usedPasses & (1u << i)))
+            continue;
+        GLint available = 0;
+        glGetQueryObjectiv(frame.queries[i][1], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available)
+            return false;
+    }
+
+    for (int i = 0; i < count; i++) {
+        if (!(frame.usedPasses & (1u << i)))
+            continue;
+        GLuint64 start = 0, stop = 0;
+        glGetQueryObjectui64v(frame.queries[i][0], GL_QUERY_RESULT, &start);
+        glGetQueryObjectui64v(frame.queries[i][1], GL_QUERY_RESULT, &stop);
+        float ms = stop > start ? (float)((stop - start) / 1.0e6) : 0.0f;
+
+        Pass& p = passes[i];
+        p.recentMs = p.samples > 0 ? p.recentMs * 0.9f + ms * 0.1f : ms;
+        if (ms > p.maxMs) p.maxMs = ms;
+        p.totalMs += ms;
+        p.samples++;
+    }
+
+    frame.usedPasses = 0;
+    return true;
+}
+
+void GpuPassTimer::beginFrame() {
+    // Oldest frame first; stop at the first one the GPU has not finished
+    for (int i = 1; i <= Latency; i++) {
+        FrameQueries& frame = frames[(current + i) % Latency];
+        if (frame.usedPasses != 0 && !resolve(frame))
+            break;
+    }
+
+    // A slot still unresolved after Latency frames is dropped rather than waited on
+    current = (current + 1) % Latency;
+    frames[current].usedPasses = 0;
+}
+
+void GpuPassTimer::begin(int pass) {
+    if (pass < 0)
+        return;
+    glQueryCounter(frames[current].queries[pass][0], GL_TIMESTAMP);
+    frames[current].usedPasses |= 1u << pass;
+}
+
+void GpuPassTimer::end(int pass) {
+    if (pass < 0)
+        return;
+    glQueryCounter(frames[current].queries[pass][1], GL_TIMESTAMP);
+}
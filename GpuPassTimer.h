@@ -0,0 +1,60 @@
+#ifndef GPU_PASS_TIMER_H
+#define GPU_PASS_TIMER_H
+
+#include <glad/glad.h>
+#include <cstdint>
+
+// Measures the GPU time of named render passes with timestamp queries. Results
+// are read back up to Latency frames later, so timing never stalls the pipeline.
+class GpuPassTimer {
+public:
+    static const int MaxPasses = 16;
+    static const int Latency = 4;
+
+    GpuPassTimer();
+    ~GpuPassTimer();
+
+    GpuPassTimer(const GpuPassTimer&) = delete;
+    GpuPassTimer& operator=(const GpuPassTimer&) = delete;
+
+    // Returns the pass id, or -1 when all slots are taken. The name must outlive the timer.
+    int addPass(const char* name);
+
+    // Call once per rendered frame before the first pass
+    void beginFrame();
+    void begin(int pass);
+    void end(int pass);
+
+    int passCount() const { return count; }
+    const char* passName(int pass) const { return passes[pass].name; }
+
+    // Smoothed recent cost, for the on-screen overlay
+    float recentMs(int pass) const { return passes[pass].recentMs; }
+    float averageMs(int pass) const;
+    float maxMs(int pass) const { return passes[pass].maxMs; }
+    uint64_t samples(int pass) const { return passes[pass].samples; }
+
+private:
+    struct Pass {
+        const char* name;
+        float recentMs;
+        float maxMs;
+        double totalMs;
+        uint64_t samples;
+    };
+
+    struct FrameQueries {
+        GLuint queries[MaxPasses][2]; // Timestamps at begin and end of each pass
+        uint32_t usedPasses;          // Bit per pass timed in this frame
+    };
+
+    bool resolve(FrameQueries& frame);
+
+    Pass passes[MaxPasses];
+    int count;
+
+    FrameQueries frames[Latency];
+    int current;
+};
+
+#endif
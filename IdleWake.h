@@ -0,0 +1,37 @@
+#ifndef IDLE_WAKE_H
+#define IDLE_WAKE_H
+
+#include <atomic>
+
+// Wakes the render loop from its idle wait when a producer thread publishes a
+// change, without posting an event for every update. The loop arms it, checks
+// once more for new data, and only then blocks; the first notify after arming
+// posts the wake-up and disarms it. Unarmed, notify is a fence and a load.
+class IdleWake {
+public:
+    explicit IdleWake(void (*post)()) : post(post), armed(false) {}
+
+    IdleWake(const IdleWake&) = delete;
+    IdleWake& operator=(const IdleWake&) = delete;
+
+    // Render loop: arm, re-check the producers, then wait or disarm
+    void arm() {
+        armed.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+
+    void disarm() { armed.store(false, std::memory_order_relaxed); }
+
+    // Producers: call after publishing a change
+    void notify() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (armed.load(std::memory_order_relaxed) && armed.exchange(false, std::memory_order_relaxed))
+            post();
+    }
+
+private:
+    void (*post)();
+    std::atomic<bool> armed;
+};
+
+#endif
@@ -0,0 +1,92 @@
+#include "InputRecording.h"
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+
+static const char RECORDING_MAGIC[4] = { 'C', 'L', 'I', 'R' };
+static const uint32_t RECORDING_VERSION = 1;
+static const size_t RECORD_BYTES = 12;
+
+// Fields are stored little-endian whatever the host order
+static uint32_t readLittle32(const uint8_t* bytes) {
+    return (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8) | ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+}
+
+static void writeLittle32(uint8_t* bytes, uint32_t value) {
+    bytes[0] = (uint8_t)value;
+    bytes[1] = (uint8_t)(value >> 8);
+    bytes[2] = (uint8_t)(value >> 16);
+    bytes[3] = (uint8_t)(value >> 24);
+}
+
+bool InputRecorder::open(const char* path) {
+    file.open(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        std::cerr << "ERROR::INPUT_RECORDER::FILE_NOT_OPENED: " << path << "\n";
+        return false;
+    }
+    uint8_t version[4];
+    writeLittle32(version, RECORDING_VERSION);
+    file.write(RECORDING_MAGIC, sizeof(RECORDING_MAGIC));
+    file.write((const char*)version, sizeof(version));
+    return true;
+}
+
+void InputRecorder::write(const InputFrame& frame) {
+    if (!file.is_open())
+        return;
+    uint32_t deltaBits;
+    memcpy(&deltaBits, &frame.deltaTime, sizeof(deltaBits));
+    uint8_t record[RECORD_BYTES];
+    writeLittle32(record, deltaBits);
+    writeLittle32(record + 4, frame.held);
+    writeLittle32(record + 8, frame.pressed);
+    file.write((const char*)record, sizeof(record));
+}
+
+void InputRecorder::close() {
+    if (file.is_open())
+        file.close();
+}
+
+bool InputReplay::open(const char* path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        std::cerr << "ERROR::INPUT_REPLAY::FILE_NOT_FOUND: " << path << "\n";
+        return false;
+    }
+
+    char magic[4];
+    uint8_t version[4];
+    file.read(magic, sizeof(magic));
+    file.read((char*)version, sizeof(version));
+    if (!file || memcmp(magic, RECORDING_MAGIC, sizeof(magic)) != 0 || readLittle32(version) != RECORDING_VERSION) {
+        std::cerr << "ERROR::INPUT_REPLAY::INVALID_HEADER: " << path << "\n";
+        return false;
+    }
+
+    frames.clear();
+    position = 0;
+    uint8_t record[RECORD_BYTES];
+    while (file.read((char*)record, sizeof(record))) {
+        InputFrame frame;
+        uint32_t deltaBits = readLittle32(record);
+        memcpy(&frame.deltaTime, &deltaBits, sizeof(frame.deltaTime));
+        frame.held = readLittle32(record + 4);
+        frame.pressed = readLittle32(record + 8);
+        frames.push_back(frame);
+    }
+
+    if (frames.empty()) {
+        std::cerr << "ERROR::INPUT_REPLAY::EMPTY_RECORDING: " << path << "\n";
+        return false;
+    }
+    return true;
+}
+
+bool InputReplay::next(InputFrame& frame) {
+    if (position >= frames.size())
+        return false;
+    frame = frames[position++];
+    return true;
+}
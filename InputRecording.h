@@ -0,0 +1,46 @@
+#ifndef INPUT_RECORDING_H
+#define INPUT_RECORDING_H
+
+#include <cstddef>
+#include <fstream>
+#include <vector>
+
+#include "VehicleInput.h"
+
+// Binary input recordings: an 8-byte header ("CLIR" and a uint32 version)
+// followed by one 12-byte record per step (float deltaTime, uint32 held mask,
+// uint32 pressed mask). Every field is little-endian.
+
+// Streams input frames to a file as they happen
+class InputRecorder {
+public:
+    bool open(const char* path);
+    bool isOpen() const { return file.is_open(); }
+
+    void write(const InputFrame& frame);
+    void close();
+
+private:
+    std::ofstream file;
+};
+
+// Loads a whole recording and hands it back one step at a time
+class InputReplay {
+public:
+    InputReplay() : position(0) {}
+
+    bool open(const char* path);
+    bool isOpen() const { return !frames.empty(); }
+
+    // Returns false once every recorded step has been played
+    bool next(InputFrame& frame);
+
+    size_t size() const { return frames.size(); }
+    size_t played() const { return position; }
+
+private:
+    std::vector<InputFrame> frames;
+    size_t position;
+};
+
+#endif
@@ -0,0 +1,63 @@
+#include "KeyboardInput.h"
+#include <GLFW/glfw3.h>
+
+KeyboardInput::KeyboardInput(const KeyBinding* bindings, size_t bindingCount)
+    : bindings(bindings), bindingCount(bindingCount), queued(0), held(0), pressed(0)
+{
+}
+
+void KeyboardInput::attach(GLFWwindow* window) {
+    glfwSetWindowUserPointer(window, this);
+    glfwSetKeyCallback(window, keyCallback);
+}
+
+void KeyboardInput::keyCallback(GLFWwindow* window, int key, int /*scancode*/, int action, int /*mods*/) {
+    // Auto-repeat carries no new state
+    if (action == GLFW_REPEAT)
+        return;
+
+    KeyboardInput* keyboard = (KeyboardInput*)glfwGetWindowUserPointer(window);
+    if (!keyboard)
+        return;
+
+    // GLFW reports unknown keys as GLFW_KEY_UNKNOWN, which no binding uses
+    for (size_t i = 0; i < keyboard->bindingCount; i++) {
+        if (keyboard->bindings[i].key == key)
+            keyboard->push(keyboard->bindings[i].action, action == GLFW_PRESS);
+    }
+}
+
+void KeyboardInput::push(InputAction action, bool down) {
+    if (queued == QueueCapacity) {
+        // Fold the oldest transition in to make room; order is kept
+        apply((InputAction)queue[0].action, queue[0].down);
+        for (size_t i = 1; i < queued; i++)
+            queue[i - 1] = queue[i];
+        queued--;
+    }
+    queue[queued].action = (uint8_t)action;
+    queue[queued].down = down;
+    queued++;
+}
+
+void KeyboardInput::apply(InputAction action, bool down) {
+    uint32_t bit = 1u << action;
+    if (down) {
+        if (!(held & bit))
+            pressed |= bit;
+        held |= bit;
+    }
+    else {
+        held &= ~bit;
+    }
+}
+
+InputFrame KeyboardInput::sample() {
+    for (size_t i = 0; i < queued; i++)
+        apply((InputAction)queue[i].action, queue[i].down);
+    queued = 0;
+
+    InputFrame input = { 0.0f, held, pressed };
+    pressed = 0;
+    return input;
+}
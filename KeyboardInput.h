@@ -0,0 +1,56 @@
+#ifndef KEYBOARD_INPUT_H
+#define KEYBOARD_INPUT_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "VehicleInput.h"
+
+struct GLFWwindow;
+
+// Which key triggers each action
+struct KeyBinding {
+    int key;
+    InputAction action;
+};
+
+// Keyboard input fed by GLFW's key callback instead of polling. Transitions of
+// bound keys are queued while GLFW dispatches events and folded into an
+// InputFrame once per step, so an idle frame only reads an empty queue and a
+// tap shorter than a frame still counts as pressed.
+class KeyboardInput {
+public:
+    KeyboardInput(const KeyBinding* bindings, size_t bindingCount);
+
+    // Install the key callback; the window's user pointer is set to this object
+    void attach(GLFWwindow* window);
+
+    // Drain the queued transitions into the actions held now and the ones
+    // that went down since the previous call. deltaTime is left at zero; the
+    // simulation steps at its own rate.
+    InputFrame sample();
+
+private:
+    static void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods);
+    void push(InputAction action, bool down);
+    void apply(InputAction action, bool down);
+
+    struct KeyEvent {
+        uint8_t action;
+        bool down;
+    };
+
+    // More transitions than this between two samples are folded in as they arrive
+    static const size_t QueueCapacity = 64;
+
+    const KeyBinding* bindings;
+    size_t bindingCount;
+
+    KeyEvent queue[QueueCapacity];
+    size_t queued;
+
+    uint32_t held;
+    uint32_t pressed;
+};
+
+#endif
@@ -0,0 +1,125 @@
+#include "MappedFile.h"
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile()
+    : bytes(nullptr), length(0)
+#ifdef _WIN32
+    , fileHandle(nullptr), mappingHandle(nullptr)
+#endif
+{
+}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+#ifdef _WIN32
+
+bool MappedFile::open(const char* path) {
+    close();
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                              FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        std::cerr << "ERROR::MAPPED_FILE::FILE_NOT_FOUND: " << path << "\n";
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+        std::cerr << "ERROR::MAPPED_FILE::EMPTY_FILE: " << path << "\n";
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    const void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+    if (!view) {
+        std::cerr << "ERROR::MAPPED_FILE::MAP_FAILED: " << path << "\n";
+        if (mapping)
+            CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    fileHandle = file;
+    mappingHandle = mapping;
+    bytes = (const char*)view;
+    length = (size_t)fileSize.QuadPart;
+    return true;
+}
+
+void MappedFile::close() {
+    if (bytes)
+        UnmapViewOfFile(bytes);
+    if (mappingHandle)
+        CloseHandle((HANDLE)mappingHandle);
+    if (fileHandle)
+        CloseHandle((HANDLE)fileHandle);
+    bytes = nullptr;
+    length = 0;
+    fileHandle = nullptr;
+    mappingHandle = nullptr;
+}
+
+// FILE_FLAG_SEQUENTIAL_SCAN already covers the read-ahead hint
+void MappedFile::adviseSequential() {}
+
+void MappedFile::release(size_t offset, size_t count) {}
+
+#else
+
+bool MappedFile::open(const char* path) {
+    close();
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "ERROR::MAPPED_FILE::FILE_NOT_FOUND: " << path << ": " << strerror(errno) << "\n";
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        std::cerr << "ERROR::MAPPED_FILE::EMPTY_FILE: " << path << "\n";
+        ::close(fd);
+        return false;
+    }
+    void* view = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // The mapping keeps the file referenced
+    if (view == MAP_FAILED) {
+        std::cerr << "ERROR::MAPPED_FILE::MAP_FAILED: " << path << ": " << strerror(errno) << "\n";
+        return false;
+    }
+    bytes = (const char*)view;
+    length = (size_t)info.st_size;
+    return true;
+}
+
+void MappedFile::close() {
+    if (bytes)
+        munmap((void*)bytes, length);
+    bytes = nullptr;
+    length = 0;
+}
+
+void MappedFile::adviseSequential() {
+    if (bytes)
+        madvise((void*)bytes, length, MADV_SEQUENTIAL);
+}
+
+void MappedFile::release(size_t offset, size_t count) {
+    if (!bytes || offset >= length)
+        return;
+    size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+    size_t begin = (offset + pageSize - 1) / pageSize * pageSize;
+    size_t end = (offset + count < length ? offset + count : length) / pageSize * pageSize;
+    if (end > begin)
+        madvise((void*)(bytes + begin), end - begin, MADV_DONTNEED);
+}
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+
+// A read-only memory mapping of a whole file. Pages are loaded on first touch
+// and belong to the page cache, so files larger than RAM can be scanned.
+class MappedFile {
+public:
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const char* path);
+    void close();
+
+    bool isOpen() const { return bytes != nullptr; }
+    const char* data() const { return bytes; }
+    size_t size() const { return length; }
+
+    // Hint that the file is read front to back
+    void adviseSequential();
+    // Drop the mapped pages of [offset, offset + count) from this process;
+    // they stay in the page cache. Offsets are rounded to whole pages inside the range.
+    void release(size_t offset, size_t count);
+
+private:
+    const char* bytes;
+    size_t length;
+#ifdef _WIN32
+    void* fileHandle;
+    void* mappingHandle;
+#endif
+};
+
+#endif
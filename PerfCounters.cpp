@@ -0,0 +1,140 @@
+#include "PerfCounters.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+PerfCounters::PerfCounters() : groupFd(-1), multiplexed(false) {
+    for (int i = 0; i < COUNTER_COUNT; i++)
+        fds[i] = -1;
+    memset(phaseStart, 0, sizeof(phaseStart));
+    memset(phaseTotal, 0, sizeof(phaseTotal));
+    memset(phaseRuns, 0, sizeof(phaseRuns));
+}
+
+PerfCounters::~PerfCounters() {
+#ifdef __linux__
+    for (int i = 0; i < COUNTER_COUNT; i++)
+        if (fds[i] >= 0)
+            close(fds[i]);
+#endif
+}
+
+#ifdef __linux__
+
+// Layout of a PERF_FORMAT_GROUP read with both time fields
+struct PerfGroupRead {
+    uint64_t count;
+    uint64_t timeEnabled;
+    uint64_t timeRunning;
+    uint64_t values[4];
+};
+
+bool PerfCounters::open() {
+    if (available())
+        return true;
+
+    const uint64_t configs[COUNTER_COUNT] = {
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_MISSES,
+        PERF_COUNT_HW_BRANCH_MISSES
+    };
+
+    for (int i = 0; i < COUNTER_COUNT; i++) {
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = configs[i];
+        attr.disabled = (i == 0);
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        // Calling thread, any CPU; the first counter leads the group
+        fds[i] = (int)syscall(SYS_perf_event_open, &attr, 0, -1, i == 0 ? -1 : fds[0], 0);
+        if (fds[i] < 0) {
+            std::cerr << "ERROR::PERF_COUNTERS::OPEN_FAILED: " << strerror(errno) << "\n";
+            for (int j = 0; j < i; j++) {
+                close(fds[j]);
+                fds[j] = -1;
+            }
+            return false;
+        }
+    }
+
+    groupFd = fds[0];
+    ioctl(groupFd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(groupFd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    return true;
+}
+
+bool PerfCounters::read(uint64_t* values) const {
+    PerfGroupRead data;
+    if (::read(groupFd, &data, sizeof(data)) != (ssize_t)sizeof(data) || data.count != COUNTER_COUNT)
+        return false;
+    for (int i = 0; i < COUNTER_COUNT; i++)
+        values[i] = data.values[i];
+    if (data.timeRunning < data.timeEnabled)
+        multiplexed = true;
+    return true;
+}
+
+#else
+
+bool PerfCounters::open() {
+    std::cerr << "ERROR::PERF_COUNTERS::UNSUPPORTED_PLATFORM\n";
+    return false;
+}
+
+bool PerfCounters::read(uint64_t*) const {
+    return false;
+}
+
+#endif
+
+void PerfCounters::begin(PerfPhase phase) {
+    if (available())
+        read(phaseStart[phase]);
+}
+
+void PerfCounters::end(PerfPhase phase) {
+    uint64_t now[COUNTER_COUNT];
+    if (!available() || !read(now))
+        return;
+    for (int i = 0; i < COUNTER_COUNT; i++)
+        phaseTotal[phase][i] += now[i] - phaseStart[phase][i];
+    phaseRuns[phase]++;
+}
+
+void PerfCounters::report(std::ostream& out) const {
+    if (!available())
+        return;
+
+    const char* phaseNames[PERF_PHASE_COUNT] = { "input", "submission", "swap" };
+
+    out << "Hardware counters per frame" << (multiplexed ? " (multiplexed, counts are partial)" : "") << ":\n";
+    out << std::fixed;
+    for (int p = 0; p < PERF_PHASE_COUNT; p++) {
+        const uint64_t* total = phaseTotal[p];
+        double frames = (double)std::max<uint64_t>(phaseRuns[p], 1);
+        double ipc = total[COUNTER_CYCLES] > 0 ? (double)total[COUNTER_INSTRUCTIONS] / total[COUNTER_CYCLES] : 0.0;
+        out << "  " << std::left << std::setw(11) << phaseNames[p] << std::right
+            << " IPC " << std::setprecision(2) << ipc
+            << ", cycles " << std::setprecision(0) << (double)total[COUNTER_CYCLES] / frames
+            << ", instructions " << (double)total[COUNTER_INSTRUCTIONS] / frames
+            << ", cache misses " << std::setprecision(1) << (double)total[COUNTER_CACHE_MISSES] / frames
+            << ", branch misses " << (double)total[COUNTER_BRANCH_MISSES] / frames
+            << " (" << phaseRuns[p] << " runs)\n";
+    }
+    out << std::defaultfloat;
+}
@@ -0,0 +1,57 @@
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <cstdint>
+#include <ostream>
+
+// Phases of a frame the hardware counters are split into
+enum PerfPhase {
+    PERF_PHASE_INPUT,      // Input handling and simulation
+    PERF_PHASE_SUBMISSION, // Building and submitting the frame's draws
+    PERF_PHASE_SWAP,       // glfwSwapBuffers
+    PERF_PHASE_COUNT
+};
+
+// CPU hardware counters (cycles, instructions, cache and branch misses) per
+// frame phase, read through perf_event_open on Linux. Elsewhere, or when the
+// kernel refuses access, open() fails and every other call does nothing.
+// Counts are user space only, so they include the GL driver's user-space work.
+class PerfCounters {
+public:
+    PerfCounters();
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    bool open();
+    bool available() const { return groupFd >= 0; }
+
+    void begin(PerfPhase phase);
+    void end(PerfPhase phase);
+
+    // IPC and average counts per run of each phase. Input also runs on
+    // frames the loop skips, so its run count can exceed the others.
+    void report(std::ostream& out) const;
+
+private:
+    enum Counter {
+        COUNTER_CYCLES,
+        COUNTER_INSTRUCTIONS,
+        COUNTER_CACHE_MISSES,
+        COUNTER_BRANCH_MISSES,
+        COUNTER_COUNT
+    };
+
+    bool read(uint64_t* values) const;
+
+    int groupFd;
+    int fds[COUNTER_COUNT];
+    mutable bool multiplexed; // The kernel time-shared the counters, so totals are partial
+
+    uint64_t phaseStart[PERF_PHASE_COUNT][COUNTER_COUNT];
+    uint64_t phaseTotal[PERF_PHASE_COUNT][COUNTER_COUNT];
+    uint64_t phaseRuns[PERF_PHASE_COUNT];
+};
+
+#endif
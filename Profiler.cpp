@@ -0,0 +1,122 @@
+#include "Profiler.h"
+#include <json/json.h>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <vector>
+
+namespace {
+    // Fields are atomic because the exporter may copy a slot while its owning
+    // thread rewrites it; such copies are discarded, but must not race
+    struct Zone {
+        std::atomic<const char*> name;
+        std::atomic<uint64_t> startNs;
+        std::atomic<uint64_t> endNs;
+    };
+
+    // Ring of one thread's most recent zones. Only the owning thread writes;
+    // the exporter reads whatever was published before it started.
+    struct ZoneBuffer {
+        static const size_t Capacity = 1 << 16; // Power of two
+
+        ZoneBuffer(int threadIndex) : threadIndex(threadIndex), written(0) {}
+
+        int threadIndex;
+        Zone zones[Capacity];
+        std::atomic<uint64_t> written;
+    };
+
+    // Buffers live until exit so zones of finished threads can still be exported
+    std::mutex registryMutex;
+    std::vector<ZoneBuffer*> registry;
+
+    const uint64_t processStartNs = Profiler::nowNs();
+
+    ZoneBuffer* createBuffer() {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        ZoneBuffer* buffer = new ZoneBuffer((int)registry.size());
+        registry.push_back(buffer);
+        return buffer;
+    }
+
+    ZoneBuffer& threadBuffer() {
+        thread_local ZoneBuffer* buffer = createBuffer();
+        return *buffer;
+    }
+}
+
+uint64_t Profiler::nowNs() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void Profiler::record(const char* name, uint64_t startNs, uint64_t endNs) {
+    ZoneBuffer& buffer = threadBuffer();
+    uint64_t index = buffer.written.load(std::memory_order_relaxed);
+    Zone& zone = buffer.zones[index & (ZoneBuffer::Capacity - 1)];
+    // Release stores: an exporter that reads any of them also sees the
+    // previous record's store of written = index, and so drops the slot
+    zone.name.store(name, std::memory_order_release);
+    zone.startNs.store(startNs, std::memory_order_release);
+    zone.endNs.store(endNs, std::memory_order_release);
+    buffer.written.store(index + 1, std::memory_order_release);
+}
+
+bool Profiler::writeChromeTrace(const char* path) {
+    std::vector<ZoneBuffer*> buffers;
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        buffers = registry;
+    }
+
+    nlohmann::json events = nlohmann::json::array();
+    for (ZoneBuffer* buffer : buffers) {
+        uint64_t end = buffer->written.load(std::memory_order_acquire);
+        uint64_t begin = end > ZoneBuffer::Capacity ? end - ZoneBuffer::Capacity : 0;
+
+        nlohmann::json threadName;
+        threadName["ph"] = "M";
+        threadName["name"] = "thread_name";
+        threadName["pid"] = 1;
+        threadName["tid"] = buffer->threadIndex;
+        threadName["args"]["name"] = buffer->threadIndex == 0 ? "main" : "thread " + std::to_string(buffer->threadIndex);
+        events.push_back(threadName);
+
+        for (uint64_t i = begin; i < end; i++) {
+            const Zone& slot = buffer->zones[i & (ZoneBuffer::Capacity - 1)];
+            const char* name = slot.name.load(std::memory_order_acquire);
+            uint64_t startNs = slot.startNs.load(std::memory_order_acquire);
+            uint64_t endNs = slot.endNs.load(std::memory_order_acquire);
+
+            // Skip entries the owning thread overwrote, or started to, while we
+            // were copying: if the copy saw any store for index i + Capacity,
+            // this load sees written - i >= Capacity
+            if (buffer->written.load(std::memory_order_relaxed) - i >= ZoneBuffer::Capacity)
+                continue;
+
+            // Complete events; Chrome trace timestamps are in microseconds
+            nlohmann::json event;
+            event["ph"] = "X";
+            event["name"] = name;
+            event["pid"] = 1;
+            event["tid"] = buffer->threadIndex;
+            event["ts"] = (int64_t)(startNs - processStartNs) / 1000.0;
+            event["dur"] = (endNs - startNs) / 1000.0;
+            events.push_back(event);
+        }
+    }
+
+    std::ofstream file(path);
+    if (!file) {
+        std::cerr << "ERROR::PROFILER::FILE_NOT_WRITTEN: " << path << "\n";
+        return false;
+    }
+
+    nlohmann::json trace;
+    trace["traceEvents"] = events;
+    trace["displayTimeUnit"] = "ns";
+    file << trace.dump() << "\n";
+    return true;
+}
@@ -0,0 +1,47 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <cstdint>
+
+// Scoped CPU zones recorded into per-thread buffers, exportable as a Chrome /
+// Perfetto trace. Recording takes two clock reads and one buffer write, so it
+// can stay enabled in release builds; define PROFILER_ENABLED=0 to compile it out.
+#ifndef PROFILER_ENABLED
+#define PROFILER_ENABLED 1
+#endif
+
+namespace Profiler {
+    // Monotonic time in nanoseconds
+    uint64_t nowNs();
+
+    // Append a finished zone to the calling thread's buffer. The name must be a
+    // string literal (or otherwise outlive the trace); it is stored by pointer.
+    void record(const char* name, uint64_t startNs, uint64_t endNs);
+
+    // Write the most recent zones of every thread as Chrome trace event JSON
+    bool writeChromeTrace(const char* path);
+
+    class ScopedZone {
+    public:
+        explicit ScopedZone(const char* name) : name(name), startNs(nowNs()) {}
+        ~ScopedZone() { record(name, startNs, nowNs()); }
+
+        ScopedZone(const ScopedZone&) = delete;
+        ScopedZone& operator=(const ScopedZone&) = delete;
+
+    private:
+        const char* name;
+        uint64_t startNs;
+    };
+}
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#if PROFILER_ENABLED
+#define PROFILE_ZONE(name) Profiler::ScopedZone PROFILE_CONCAT(profileZone, __LINE__)(name)
+#else
+#define PROFILE_ZONE(name) ((void)0)
+#endif
+
+#endif
@@ -0,0 +1,100 @@
+#include "QuadBatch.h"
+#include "Shader.h"
+#include "Profiler.h"
+
+QuadBatch::QuadBatch(size_t initialCapacity)
+    : VAO(0), VBO(0), EBO(0), quadCount(0), uploadedQuads(0), capacity(0)
+{
+    glGenVertexArrays(1, &VAO);
+    glGenBuffers(1, &VBO);
+    glGenBuffers(1, &EBO);
+
+    glBindVertexArray(VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+
+    // Position
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(QuadVertex), (void*)0);
+    glEnableVertexAttribArray(0);
+    // Color + alpha
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(QuadVertex), (void*)(2 * sizeof(float)));
+    glEnableVertexAttribArray(1);
+
+    reserveGPU(initialCapacity);
+    vertices.reserve(initialCapacity * 4);
+}
+
+QuadBatch::~QuadBatch() {
+    glDeleteVertexArrays(1, &VAO);
+    glDeleteBuffers(1, &VBO);
+    glDeleteBuffers(1, &EBO);
+}
+
+void QuadBatch::reserveGPU(size_t quads) {
+    // Indices never change for a given capacity, so they are built once here
+    std::vector<GLuint> indices;
+    indices.reserve(quads * 6);
+    for (size_t i = 0; i < quads; i++) {
+        GLuint base = (GLuint)(i * 4);
+        indices.push_back(base);
+        indices.push_back(base + 1);
+        indices.push_back(base + 2);
+        indices.push_back(base);
+        indices.push_back(base + 2);
+        indices.push_back(base + 3);
+    }
+
+    glBindVertexArray(VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    glBufferData(GL_ARRAY_BUFFER, quads * 4 * sizeof(QuadVertex), NULL, GL_STREAM_DRAW);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLuint), indices.data(), GL_STATIC_DRAW);
+
+    capacity = quads;
+}
+
+void QuadBatch::add(float x, float y, float width, float height, float r, float g, float b, float a) {
+    vertices.push_back({ x, y, r, g, b, a });
+    vertices.push_back({ x + width, y, r, g, b, a });
+    vertices.push_back({ x + width, y + height, r, g, b, a });
+    vertices.push_back({ x, y + height, r, g, b, a });
+    quadCount++;
+}
+
+void QuadBatch::flush(const Shader& shader) {
+    PROFILE_ZONE("QuadBatch::flush");
+    if (quadCount == 0)
+        return;
+    upload();
+    draw(shader);
+}
+
+void QuadBatch::upload() {
+    uploadedQuads = quadCount;
+    if (quadCount == 0)
+        return;
+
+    // Only grows when a frame queues more rectangles than ever before
+    if (quadCount > capacity) {
+        size_t newCapacity = capacity > 0 ? capacity * 2 : 64;
+        while (newCapacity < quadCount) newCapacity *= 2;
+        reserveGPU(newCapacity);
+    }
+
+    glBindVertexArray(VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+
+    // Orphan the previous frame's storage so the driver never waits on it
+    glBufferData(GL_ARRAY_BUFFER, capacity * 4 * sizeof(QuadVertex), NULL, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, vertices.size() * sizeof(QuadVertex), vertices.data());
+
+    vertices.clear();
+    quadCount = 0;
+}
+
+void QuadBatch::draw(const Shader& shader) const {
+    if (uploadedQuads == 0)
+        return;
+    shader.use();
+    glBindVertexArray(VAO);
+    glDrawElements(GL_TRIANGLES, (GLsizei)(uploadedQuads * 6), GL_UNSIGNED_INT, (void*)0);
+}
@@ -0,0 +1,47 @@
+#ifndef QUAD_BATCH_H
+#define QUAD_BATCH_H
+
+#include <glad/glad.h>
+#include <cstddef>
+#include <vector>
+
+class Shader; // Forward declaration
+
+// Collects axis-aligned rectangles for a frame and draws them with a single
+// indexed draw call from one persistent VAO and a streaming VBO.
+class QuadBatch {
+public:
+    explicit QuadBatch(size_t initialCapacity = 64);
+    ~QuadBatch();
+
+    // Queue a rectangle in cluster coordinates (same space as the gauges)
+    void add(float x, float y, float width, float height, float r, float g, float b, float a = 1.0f);
+
+    // Upload every queued rectangle and draw them in submission order
+    void flush(const Shader& shader);
+
+    // Retained use: upload the queued rectangles once, then draw them every
+    // frame until the next upload
+    void upload();
+    void draw(const Shader& shader) const;
+
+    size_t size() const { return quadCount; }
+
+private:
+    struct QuadVertex {
+        float x, y;
+        float r, g, b, a;
+    };
+
+    void reserveGPU(size_t quads);
+
+    // OpenGL objects
+    GLuint VAO, VBO, EBO;
+
+    std::vector<QuadVertex> vertices;
+    size_t quadCount;
+    size_t uploadedQuads;
+    size_t capacity; // quads the VBO/EBO can currently hold
+};
+
+#endif
@@ -0,0 +1,48 @@
+#include "RenderTarget.h"
+#include <iostream>
+
+RenderTarget::RenderTarget()
+    : FBO(0), colorTexture(0), targetWidth(0), targetHeight(0)
+{
+}
+
+RenderTarget::~RenderTarget() {
+    if (FBO) {
+        glDeleteFramebuffers(1, &FBO);
+        glDeleteTextures(1, &colorTexture);
+    }
+}
+
+void RenderTarget::resize(int width, int height) {
+    if (FBO && width == targetWidth && height == targetHeight)
+        return;
+
+    if (!FBO) {
+        glGenFramebuffers(1, &FBO);
+        glGenTextures(1, &colorTexture);
+    }
+
+    glBindTexture(GL_TEXTURE_2D, colorTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    GLint previousFBO = 0;
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previousFBO);
+    glBindFramebuffer(GL_FRAMEBUFFER, FBO);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, colorTexture, 0);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        std::cerr << "ERROR::FRAMEBUFFER_INCOMPLETE " << width << "x" << height << "\n";
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, (GLuint)previousFBO);
+
+    targetWidth = width;
+    targetHeight = height;
+}
+
+void RenderTarget::bind() const {
+    glBindFramebuffer(GL_FRAMEBUFFER, FBO);
+    glViewport(0, 0, targetWidth, targetHeight);
+}
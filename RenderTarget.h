@@ -0,0 +1,33 @@
+#ifndef RENDER_TARGET_H
+#define RENDER_TARGET_H
+
+#include <glad/glad.h>
+
+// An RGBA8 color texture attached to its own framebuffer object.
+// GL objects are created on the first resize, so unused targets cost nothing.
+class RenderTarget {
+public:
+    RenderTarget();
+    ~RenderTarget();
+
+    RenderTarget(const RenderTarget&) = delete;
+    RenderTarget& operator=(const RenderTarget&) = delete;
+
+    // Allocate storage for the given size; a no-op if it already matches
+    void resize(int width, int height);
+
+    // Bind as the draw framebuffer and set the viewport to cover it
+    void bind() const;
+
+    bool valid() const { return FBO != 0; }
+    GLuint framebuffer() const { return FBO; }
+    GLuint texture() const { return colorTexture; }
+    int width() const { return targetWidth; }
+    int height() const { return targetHeight; }
+
+private:
+    GLuint FBO, colorTexture;
+    int targetWidth, targetHeight;
+};
+
+#endif
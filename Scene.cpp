@@ -0,0 +1,138 @@
+#include "Scene.h"
+#include "Shader.h"
+#include "Profiler.h"
+#include <cstring>
+
+Scene::Scene(size_t initialCapacity)
+    : UBO(0), stride(0), capacity(0),
+      building(-1), relayout(false), uploadedRecords(0)
+{
+    GLint alignment = 256;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    if (alignment <= 0) alignment = 256;
+    stride = (sizeof(DrawParams) + alignment - 1) / alignment * alignment;
+
+    glGenBuffers(1, &UBO);
+    reserveGPU(initialCapacity);
+}
+
+Scene::~Scene() {
+    glDeleteBuffers(1, &UBO);
+}
+
+void Scene::reserveGPU(size_t records) {
+    glBindBuffer(GL_UNIFORM_BUFFER, UBO);
+    glBufferData(GL_UNIFORM_BUFFER, records * stride, NULL, GL_DYNAMIC_DRAW);
+    capacity = records;
+}
+
+int Scene::addNode(uint32_t inputs) {
+    SceneNode node;
+    node.inputs = inputs;
+    node.dirty = true;
+    node.stale = false;
+    node.firstRecord = 0;
+    node.reserved = 0;
+    nodes.push_back(node);
+    relayout = true;
+    return (int)nodes.size() - 1;
+}
+
+void Scene::invalidate(uint32_t changedChannels) {
+    for (SceneNode& node : nodes) {
+        if (node.inputs & changedChannels)
+            node.dirty = true;
+    }
+}
+
+void Scene::invalidateAll() {
+    for (SceneNode& node : nodes)
+        node.dirty = true;
+}
+
+void Scene::beginNode(int node) {
+    SceneNode& n = nodes[node];
+    n.draws.clear();
+    n.params.clear();
+    n.dirty = false;
+    n.stale = true;
+    building = node;
+}
+
+void Scene::push(GLuint vao, GLenum mode, GLint first, GLsizei count, const DrawParams& params, GLuint texture) {
+    SceneNode& n = nodes[building];
+    n.draws.push_back({ vao, mode, first, count, texture });
+    n.params.push_back(params);
+    if (n.params.size() > n.reserved)
+        relayout = true;
+}
+
+void Scene::upload() {
+    PROFILE_ZONE("Scene::upload");
+    uploadedRecords = 0;
+    building = -1;
+
+    if (relayout) {
+        // Give every node as many records as it has ever used, so a node
+        // that shrinks and grows back does not lay the scene out again
+        size_t total = 0;
+        for (SceneNode& node : nodes) {
+            if (node.params.size() > node.reserved)
+                node.reserved = node.params.size();
+            node.firstRecord = total;
+            node.stale = true;
+            total += node.reserved;
+        }
+        if (total > capacity) {
+            size_t newCapacity = capacity > 0 ? capacity * 2 : 32;
+            while (newCapacity < total) newCapacity *= 2;
+            reserveGPU(newCapacity);
+        }
+        staging.assign(total * stride, 0);
+        relayout = false;
+    }
+
+    // Regenerated records go into the CPU copy; the rest of it is as uploaded
+    for (SceneNode& node : nodes) {
+        if (!node.stale)
+            continue;
+        for (size_t i = 0; i < node.params.size(); i++)
+            std::memcpy(&staging[(node.firstRecord + i) * stride], &node.params[i], sizeof(DrawParams));
+        uploadedRecords += node.params.size();
+        node.stale = false;
+    }
+    if (uploadedRecords == 0)
+        return;
+
+    // Orphan and refill in one go rather than patching ranges the GPU may
+    // still be reading from the last frame, which would stall on it
+    glBindBuffer(GL_UNIFORM_BUFFER, UBO);
+    glBufferData(GL_UNIFORM_BUFFER, capacity * stride, NULL, GL_DYNAMIC_DRAW);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, staging.size(), staging.data());
+}
+
+void Scene::drawNode(const Shader& shader, int node) {
+    PROFILE_ZONE("Scene::drawNode");
+    const SceneNode& n = nodes[node];
+    if (n.draws.empty())
+        return;
+
+    shader.use();
+    GLuint boundVAO = 0;
+    GLuint boundTexture = 0;
+    for (size_t i = 0; i < n.draws.size(); i++) {
+        const SceneDraw& draw = n.draws[i];
+        glBindBufferRange(GL_UNIFORM_BUFFER, DRAW_BLOCK_BINDING, UBO,
+                          (GLintptr)((n.firstRecord + i) * stride), sizeof(DrawParams));
+        if (draw.vao != boundVAO) {
+            glBindVertexArray(draw.vao);
+            boundVAO = draw.vao;
+        }
+        if (draw.texture != 0 && draw.texture != boundTexture) {
+            glActiveTexture(GL_TEXTURE0);
+            glBindTexture(GL_TEXTURE_2D, draw.texture);
+            boundTexture = draw.texture;
+        }
+        glDrawArrays(draw.mode, draw.first, draw.count);
+    }
+}
@@ -0,0 +1,87 @@
+#ifndef SCENE_H
+#define SCENE_H
+
+#include <glad/glad.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "UniformBlocks.h"
+
+class Shader; // Forward declaration
+
+// Retained widget nodes for the cluster. A node holds draws (a geometry
+// reference plus the DrawBlock transform and color) and the mask of signal
+// channels it is built from. Nodes stay as built, in a uniform buffer, until
+// a channel they depend on changes; only then is the node rebuilt, and the
+// buffer is only re-uploaded in frames where some node was. Drawing a node is
+// a range bind and a draw call per record, with no CPU work to regenerate it.
+//
+// Per frame: invalidate() with the changed channels, rebuild the dirty nodes
+// with beginNode() and push(), upload(), then drawNode() in any order.
+class Scene {
+public:
+    explicit Scene(size_t initialCapacity = 64);
+    ~Scene();
+
+    Scene(const Scene&) = delete;
+    Scene& operator=(const Scene&) = delete;
+
+    // Add an empty, dirty node built from the channels in inputs
+    int addNode(uint32_t inputs);
+
+    // Mark the nodes built from any of the changed channels
+    void invalidate(uint32_t changedChannels);
+    void invalidateNode(int node) { nodes[node].dirty = true; }
+    void invalidateAll();
+    bool isDirty(int node) const { return nodes[node].dirty; }
+
+    // Rebuild a node: drop its draws, then push the new ones. Same shape as
+    // DrawQueue::push, so widgets can build into either.
+    void beginNode(int node);
+    void push(GLuint vao, GLenum mode, GLint first, GLsizei count, const DrawParams& params, GLuint texture = 0);
+
+    // Upload the records if any node was rebuilt since the last upload
+    void upload();
+
+    void drawNode(const Shader& shader, int node);
+
+    size_t nodeCount() const { return nodes.size(); }
+    // Records regenerated for the last upload(), 0 when it uploaded nothing
+    size_t lastUploadRecords() const { return uploadedRecords; }
+
+private:
+    struct SceneDraw {
+        GLuint vao;
+        GLenum mode;
+        GLint first;
+        GLsizei count;
+        GLuint texture;
+    };
+
+    struct SceneNode {
+        uint32_t inputs;
+        bool dirty;      // Inputs changed since the node was built
+        bool stale;      // Built but not uploaded yet
+        size_t firstRecord; // Where its records sit in the uniform buffer
+        size_t reserved;    // Records set aside for it there
+        std::vector<SceneDraw> draws;
+        std::vector<DrawParams> params;
+    };
+
+    void reserveGPU(size_t records);
+
+    // OpenGL objects
+    GLuint UBO;
+
+    size_t stride;   // sizeof(DrawParams) rounded up to the UBO offset alignment
+    size_t capacity; // records the UBO can currently hold
+
+    std::vector<SceneNode> nodes;
+    int building;    // Node being rebuilt, or -1
+    bool relayout;   // A node outgrew its records; lay every node out again
+    size_t uploadedRecords;
+    std::vector<unsigned char> staging; // Every node's records, as uploaded
+};
+
+#endif
@@ -0,0 +1,63 @@
+#include "SdfGaugeRenderer.h"
+#include "Shader.h"
+#include "UniformBlocks.h"
+#include "Profiler.h"
+#include <iostream>
+
+SdfGaugeRenderer::SdfGaugeRenderer()
+    : VAO(0), VBO(0), UBO(0), gaugeCount(0)
+{
+    const float corners[] = {
+        -1.0f, -1.0f,
+         1.0f, -1.0f,
+         1.0f,  1.0f,
+        -1.0f,  1.0f
+    };
+
+    glGenVertexArrays(1, &VAO);
+    glGenBuffers(1, &VBO);
+    glGenBuffers(1, &UBO);
+
+    glBindVertexArray(VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(corners), corners, GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+
+    glBindBuffer(GL_UNIFORM_BUFFER, UBO);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(gauges), NULL, GL_STREAM_DRAW);
+}
+
+SdfGaugeRenderer::~SdfGaugeRenderer() {
+    glDeleteVertexArrays(1, &VAO);
+    glDeleteBuffers(1, &VBO);
+    glDeleteBuffers(1, &UBO);
+}
+
+bool SdfGaugeRenderer::add(const SdfGaugeParams& params) {
+    if (gaugeCount == MaxGauges) {
+        std::cerr << "ERROR::SDF_GAUGES::QUEUE_FULL: more than " << MaxGauges
+                  << " gauges queued before a flush; the gauge is not drawn\n";
+        return false;
+    }
+    gauges[gaugeCount++] = params;
+    return true;
+}
+
+void SdfGaugeRenderer::flush(const Shader& shader) {
+    PROFILE_ZONE("SdfGaugeRenderer::flush");
+    if (gaugeCount == 0)
+        return;
+
+    shader.use();
+
+    glBindBuffer(GL_UNIFORM_BUFFER, UBO);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(gauges), NULL, GL_STREAM_DRAW);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, gaugeCount * sizeof(SdfGaugeParams), gauges);
+    glBindBufferBase(GL_UNIFORM_BUFFER, SDF_BLOCK_BINDING, UBO);
+
+    glBindVertexArray(VAO);
+    glDrawArraysInstanced(GL_TRIANGLE_FAN, 0, 4, gaugeCount);
+
+    gaugeCount = 0;
+}
@@ -0,0 +1,56 @@
+#ifndef SDF_GAUGE_RENDERER_H
+#define SDF_GAUGE_RENDERER_H
+
+#include <glad/glad.h>
+
+class Shader; // Forward declaration
+
+// std140 mirror of one element of:
+//   layout(std140) uniform SdfBlock { SdfGauge gauges[16]; };
+// Angles are in radians; a negative sweep runs clockwise. Radii are
+// fractions of the gauge radius unless noted.
+struct SdfGaugeParams {
+    float geometry[4];    // center x, center y, radius (cluster units), quad half size (cluster units)
+    float arc[4];         // start angle, signed sweep, needle angle, flags (1 = main gauge, 2 = partial arc)
+    float ticks[4];       // major tick count, minor ticks per major, major tick inner, major tick outer
+    float scales[4];      // face, hub, minor tick inner, minor tick outer
+    float bezelColor[4];
+    float faceColor[4];
+    float glowColor[4];
+    float tickColor[4];
+    float needleColor[4];
+    float hubColor[4];
+};
+
+static_assert(sizeof(SdfGaugeParams) == 160, "SdfGaugeParams must match the std140 SdfGauge layout");
+
+// Draws every gauge as one screen-aligned quad whose fragment shader
+// evaluates signed distances for the rings, arcs, ticks, needle and hub,
+// with analytic antialiasing. The gauges queued since the last flush go out in
+// one instanced draw; the cluster flushes after each gauge so every gauge has
+// its own GPU timer pass.
+class SdfGaugeRenderer {
+public:
+    static const int MaxGauges = 16; // Must match the SdfBlock array size
+
+    SdfGaugeRenderer();
+    ~SdfGaugeRenderer();
+
+    SdfGaugeRenderer(const SdfGaugeRenderer&) = delete;
+    SdfGaugeRenderer& operator=(const SdfGaugeRenderer&) = delete;
+
+    // False, with an error, when MaxGauges are already queued
+    bool add(const SdfGaugeParams& params);
+
+    // Upload the queued gauges and draw them in submission order
+    void flush(const Shader& shader);
+
+private:
+    // OpenGL objects
+    GLuint VAO, VBO, UBO;
+
+    SdfGaugeParams gauges[MaxGauges];
+    int gaugeCount;
+};
+
+#endif
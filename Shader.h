@@ -2,9 +2,22 @@
 #define SHADER_H
 
 #include <glad/glad.h>
+#include <cstdint>
 #include <string>
 #include <iostream>
 
+// FNV-1a hash of a uniform name, usable at compile time
+constexpr uint32_t hashUniformName(const char* name, uint32_t hash = 2166136261u) {
+    return *name ? hashUniformName(name + 1, (hash ^ (uint8_t)*name) * 16777619u) : hash;
+}
+
+// Typed handle for a uniform. Declare these constexpr so the hash is folded
+// at compile time and setters never build strings or query the driver.
+struct UniformName {
+    uint32_t hash;
+    constexpr explicit UniformName(const char* name) : hash(hashUniformName(name)) {}
+};
+
 class Shader {
 public:
     GLuint ID;
@@ -32,28 +45,50 @@ public:
         // Delete shaders
         glDeleteShader(vertex);
         glDeleteShader(fragment);
+
+        cacheUniformLocations();
     }
 
     void use() const { glUseProgram(ID); }
 
-    void setFloat(const std::string& name, float value) const {
-        glUniform1f(glGetUniformLocation(ID, name.c_str()), value);
+    // Attach a named uniform block to a binding point; done once at setup
+    void bindUniformBlock(const char* blockName, GLuint binding) const {
+        GLuint index = glGetUniformBlockIndex(ID, blockName);
+        if (index != GL_INVALID_INDEX)
+            glUniformBlockBinding(ID, index, binding);
+    }
+
+    // Location resolved at link time, -1 if the program has no such uniform
+    GLint location(UniformName name) const {
+        for (int i = 0; i < uniformCount; i++) {
+            if (uniforms[i].hash == name.hash)
+                return uniforms[i].location;
+        }
+        return -1;
     }
 
-    void setVec2(const std::string& name, float x, float y) const {
-        glUniform2f(glGetUniformLocation(ID, name.c_str()), x, y);
+    void setFloat(UniformName name, float value) const {
+        glUniform1f(location(name), value);
     }
 
-    void setVec3(const std::string& name, float x, float y, float z) const {
-        glUniform3f(glGetUniformLocation(ID, name.c_str()), x, y, z);
+    void setVec2(UniformName name, float x, float y) const {
+        glUniform2f(location(name), x, y);
     }
 
-    void setBool(const std::string& name, bool value) const {
-        glUniform1i(glGetUniformLocation(ID, name.c_str()), (int)value);
+    void setVec3(UniformName name, float x, float y, float z) const {
+        glUniform3f(location(name), x, y, z);
     }
 
-    void setInt(const std::string& name, int value) const {
-        glUniform1i(glGetUniformLocation(ID, name.c_str()), value);
+    void setBool(UniformName name, bool value) const {
+        glUniform1i(location(name), (int)value);
+    }
+
+    void setInt(UniformName name, int value) const {
+        glUniform1i(location(name), value);
+    }
+
+    void setUVec2(UniformName name, GLuint x, GLuint y) const {
+        glUniform2ui(location(name), x, y);
     }
 
     ~Shader() {
@@ -61,6 +96,66 @@ public:
     }
 
 private:
+    static const int MaxUniforms = 32;
+
+    struct UniformSlot {
+        uint32_t hash;
+        GLint location;
+    };
+
+    UniformSlot uniforms[MaxUniforms];
+    int uniformCount = 0;
+
+    // Enumerate the linked program's active uniforms once so per-frame
+    // setters are a short scan over a fixed table. Names whose hashes collide,
+    // or that do not fit the table, would be set through the wrong location
+    // or not at all, so both are reported here.
+    void cacheUniformLocations() {
+        GLint activeUniforms = 0;
+        glGetProgramiv(ID, GL_ACTIVE_UNIFORMS, &activeUniforms);
+        std::string names[MaxUniforms];
+
+        for (GLint i = 0; i < activeUniforms; i++) {
+            GLchar name[256];
+            GLsizei length = 0;
+            GLint size = 0;
+            GLenum type = 0;
+            glGetActiveUniform(ID, (GLuint)i, sizeof(name), &length, &size, &type, name);
+
+            // Arrays are reported as "name[0]"; register them under "name"
+            for (GLsizei c = 0; c < length; c++) {
+                if (name[c] == '[') {
+                    name[c] = '\0';
+                    break;
+                }
+            }
+
+            GLint loc = glGetUniformLocation(ID, name);
+            if (loc < 0)
+                continue; // Uniform block member
+
+            if (uniformCount == MaxUniforms) {
+                std::cerr << "ERROR::SHADER::TOO_MANY_UNIFORMS: " << name << " does not fit the "
+                          << MaxUniforms << "-entry table\n";
+                continue;
+            }
+            uint32_t hash = hashUniformName(name);
+            int existing = 0;
+            while (existing < uniformCount && uniforms[existing].hash != hash)
+                existing++;
+            if (existing < uniformCount) {
+                std::cerr << "ERROR::SHADER::UNIFORM_HASH_COLLISION: " << name << " and "
+                          << names[existing] << "\n";
+                continue;
+            }
+
+            names[uniformCount] = name;
+            uniforms[uniformCount].hash = hash;
+            uniforms[uniformCount].location = loc;
+            uniformCount++;
+        }
+    }
+
     void checkCompileErrors(GLuint shader, std::string type) {
         GLint success;
         GLchar infoLog[1024];
@@ -0,0 +1,243 @@
+#include "SharedVehicleState.h"
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+const size_t PAYLOAD_WORDS = sizeof(SharedVehiclePayload) / sizeof(uint32_t);
+
+#ifndef _WIN32
+
+// Create the block if it does not exist yet. ftruncate zero-fills it, and a
+// zero-filled block is valid, so there is no initialization to race on.
+static SharedVehicleBlock* mapBlock(const char* name) {
+    int fd = shm_open(name, O_RDWR | O_CREAT, 0666);
+    if (fd < 0) {
+        std::cerr << "ERROR::SHARED_STATE::OPEN_FAILED: " << name << ": " << std::strerror(errno) << "\n";
+        return nullptr;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 ||
+        ((size_t)info.st_size < sizeof(SharedVehicleBlock) && ftruncate(fd, sizeof(SharedVehicleBlock)) != 0)) {
+        std::cerr << "ERROR::SHARED_STATE::RESIZE_FAILED: " << name << ": " << std::strerror(errno) << "\n";
+        ::close(fd);
+        return nullptr;
+    }
+    void* memory = mmap(nullptr, sizeof(SharedVehicleBlock), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (memory == MAP_FAILED) {
+        std::cerr << "ERROR::SHARED_STATE::MAP_FAILED: " << name << ": " << std::strerror(errno) << "\n";
+        return nullptr;
+    }
+
+    SharedVehicleBlock* block = (SharedVehicleBlock*)memory;
+    uint32_t magic = block->magic.load(std::memory_order_acquire);
+    if (magic != 0 && (magic != SHARED_VEHICLE_MAGIC ||
+                       block->version.load(std::memory_order_relaxed) != SHARED_VEHICLE_VERSION)) {
+        std::cerr << "ERROR::SHARED_STATE::INCOMPATIBLE_BLOCK: " << name << "\n";
+        munmap(memory, sizeof(SharedVehicleBlock));
+        return nullptr;
+    }
+    return block;
+}
+
+static void unmapBlock(SharedVehicleBlock* block) {
+    munmap(block, sizeof(SharedVehicleBlock));
+}
+
+static uint32_t currentProcess() {
+    return (uint32_t)getpid();
+}
+
+// A writer that crashed never frees its slot; ESRCH tells us it is gone
+static bool processExited(uint32_t pid) {
+    return kill((pid_t)pid, 0) != 0 && errno == ESRCH;
+}
+
+#else
+
+static SharedVehicleBlock* mapBlock(const char* name) {
+    std::cerr << "ERROR::SHARED_STATE::UNSUPPORTED_PLATFORM: POSIX shared memory is not available for " << name << "\n";
+    return nullptr;
+}
+
+static void unmapBlock(SharedVehicleBlock*) {
+}
+
+static uint32_t currentProcess() {
+    return 0;
+}
+
+static bool processExited(uint32_t) {
+    return false;
+}
+
+#endif
+
+SharedVehicleWriter::SharedVehicleWriter() : block(nullptr), slot(nullptr) {
+    std::memset(&staged, 0, sizeof(staged));
+}
+
+SharedVehicleWriter::~SharedVehicleWriter() {
+    close();
+}
+
+bool SharedVehicleWriter::open(const char* name) {
+    close();
+    block = mapBlock(name);
+    if (!block)
+        return false;
+
+    block->version.store(SHARED_VEHICLE_VERSION, std::memory_order_relaxed);
+    block->magic.store(SHARED_VEHICLE_MAGIC, std::memory_order_release);
+
+    // Claim a free slot, or one whose writer exited without closing. Slots
+    // held by this process belong to its other writers.
+    uint32_t self = currentProcess();
+    for (int i = 0; i < SHARED_VEHICLE_MAX_WRITERS && !slot; i++) {
+        uint32_t owner = block->slots[i].owner.load(std::memory_order_relaxed);
+        if (owner != 0 && (owner == self || !processExited(owner)))
+            continue;
+        if (block->slots[i].owner.compare_exchange_strong(owner, self, std::memory_order_acquire))
+            slot = &block->slots[i];
+    }
+    if (!slot) {
+        std::cerr << "ERROR::SHARED_STATE::WRITER_SLOTS_FULL: " << name << " already has "
+                  << SHARED_VEHICLE_MAX_WRITERS << " writers\n";
+        unmapBlock(block);
+        block = nullptr;
+        return false;
+    }
+    block->generation.fetch_add(1, std::memory_order_relaxed);
+
+    // Start from nothing driven, in case an earlier writer died mid-publish
+    // and left the sequence odd
+    std::memset(&staged, 0, sizeof(staged));
+    if (slot->sequence.load(std::memory_order_relaxed) & 1)
+        slot->sequence.fetch_add(1, std::memory_order_relaxed);
+    publish();
+    return true;
+}
+
+void SharedVehicleWriter::close() {
+    if (!block)
+        return;
+    staged.fields = 0;
+    publish();
+    slot->owner.store(0, std::memory_order_release);
+    unmapBlock(block);
+    block = nullptr;
+    slot = nullptr;
+}
+
+void SharedVehicleWriter::set(VehicleField field, float value) {
+    if (field < 0 || field >= FIELD_COUNT)
+        return;
+    staged.values[field] = value;
+    staged.fields |= 1u << field;
+}
+
+void SharedVehicleWriter::clear(VehicleField field) {
+    if (field < 0 || field >= FIELD_COUNT)
+        return;
+    staged.fields &= ~(1u << field);
+}
+
+void SharedVehicleWriter::publish() {
+    if (!block)
+        return;
+    uint32_t words[PAYLOAD_WORDS];
+    std::memcpy(words, &staged, sizeof(staged));
+
+    // Odd while writing; the release fence keeps the payload stores after it.
+    // Only the slot's owner stores to its sequence, so plain stores suffice.
+    uint32_t sequence = slot->sequence.load(std::memory_order_relaxed);
+    slot->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < PAYLOAD_WORDS; i++)
+        slot->words[i].store(words[i], std::memory_order_relaxed);
+    slot->sequence.store(sequence + 2, std::memory_order_release);
+}
+
+SharedVehicleReader::SharedVehicleReader() : block(nullptr), latestFields(0), latestGeneration(0) {
+    std::memset(lastSequence, 0, sizeof(lastSequence));
+    std::memset(slotPayloads, 0, sizeof(slotPayloads));
+}
+
+SharedVehicleReader::~SharedVehicleReader() {
+    close();
+}
+
+bool SharedVehicleReader::open(const char* name) {
+    close();
+    block = mapBlock(name);
+    std::memset(lastSequence, 0, sizeof(lastSequence));
+    std::memset(slotPayloads, 0, sizeof(slotPayloads));
+    latestFields = 0;
+    return block != nullptr;
+}
+
+void SharedVehicleReader::close() {
+    if (!block)
+        return;
+    unmapBlock(block);
+    block = nullptr;
+}
+
+bool SharedVehicleReader::poll() {
+    if (!block)
+        return false;
+
+    bool changed = false;
+    for (int i = 0; i < SHARED_VEHICLE_MAX_WRITERS; i++) {
+        if (pollSlot(i))
+            changed = true;
+    }
+    if (!changed)
+        return false;
+
+    // Merge from the last slot down so the lowest-numbered writer wins
+    latestFields = 0;
+    for (int i = SHARED_VEHICLE_MAX_WRITERS - 1; i >= 0; i--) {
+        uint32_t fields = slotPayloads[i].fields & ((1u << FIELD_COUNT) - 1);
+        for (int field = 0; field < FIELD_COUNT; field++) {
+            if ((fields >> field) & 1u)
+                setVehicleField(latest, (VehicleField)field, slotPayloads[i].values[field]);
+        }
+        latestFields |= fields;
+    }
+    latestGeneration = block->generation.load(std::memory_order_relaxed);
+    return true;
+}
+
+bool SharedVehicleReader::pollSlot(int index) {
+    SharedVehicleSlot& slot = block->slots[index];
+    for (int attempt = 0; attempt < MaxReadAttempts; attempt++) {
+        uint32_t before = slot.sequence.load(std::memory_order_acquire);
+        if (before == lastSequence[index])
+            return false;
+        if (before & 1)
+            continue;
+
+        uint32_t words[PAYLOAD_WORDS];
+        for (size_t i = 0; i < PAYLOAD_WORDS; i++)
+            words[i] = slot.words[i].load(std::memory_order_relaxed);
+        // Keep the payload loads before the second sequence load
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) != before)
+            continue;
+
+        std::memcpy(&slotPayloads[index], words, sizeof(SharedVehiclePayload));
+        lastSequence[index] = before;
+        return true;
+    }
+    // The writer kept publishing through every attempt; the next frame retries
+    return false;
+}
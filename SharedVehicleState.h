@@ -0,0 +1,120 @@
+#ifndef SHARED_VEHICLE_STATE_H
+#define SHARED_VEHICLE_STATE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "Vehicle.h"
+
+// Vehicle values exchanged with other processes through POSIX shared memory.
+// Each writer process claims a slot of its own and publishes into it with a
+// seqlock: no syscalls, locks or serialization, just stores into the mapped
+// block. The cluster reads a consistent copy of every slot at the start of
+// each frame and merges the fields they drive.
+
+const char* const SHARED_VEHICLE_DEFAULT_NAME = "/cluster_vehicle_state";
+const uint32_t SHARED_VEHICLE_MAGIC = 0x53564c43;  // "CLVS"
+const uint32_t SHARED_VEHICLE_VERSION = 2;
+const int SHARED_VEHICLE_MAX_FIELDS = 32;
+const int SHARED_VEHICLE_MAX_WRITERS = 4;
+
+// What a writer publishes: a value per VehicleField, and the mask of the
+// fields it drives. Switches are on for any non-zero value.
+struct SharedVehiclePayload {
+    uint32_t fields;
+    float values[SHARED_VEHICLE_MAX_FIELDS];
+};
+
+static_assert(FIELD_COUNT <= SHARED_VEHICLE_MAX_FIELDS, "Shared block holds 32 fields");
+
+// One writer's seqlock. Only the process named by owner stores to it, so
+// the sequence never sees two publishes at once. The payload is kept in
+// atomic words so the seqlock's racy copies are well-defined; the words are
+// only ever accessed relaxed. Slots sit on their own cache lines so writers
+// do not slow each other down.
+struct alignas(64) SharedVehicleSlot {
+    std::atomic<uint32_t> owner;      // Writer process id, 0 while free
+    std::atomic<uint32_t> sequence;   // Odd while a publish is in progress
+    std::atomic<uint32_t> words[sizeof(SharedVehiclePayload) / sizeof(uint32_t)];
+};
+
+// The shared memory layout. A new, zero-filled block is valid and empty.
+struct SharedVehicleBlock {
+    std::atomic<uint32_t> magic;      // Set by the first writer
+    std::atomic<uint32_t> version;
+    std::atomic<uint32_t> generation; // Bumped each time a writer attaches
+    SharedVehicleSlot slots[SHARED_VEHICLE_MAX_WRITERS];
+};
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "Shared block needs lock-free atomics");
+
+// The writer library: stage values, then publish them as one update
+class SharedVehicleWriter {
+public:
+    SharedVehicleWriter();
+    ~SharedVehicleWriter();
+
+    SharedVehicleWriter(const SharedVehicleWriter&) = delete;
+    SharedVehicleWriter& operator=(const SharedVehicleWriter&) = delete;
+
+    // Create or attach to the block and claim a free writer slot, taking
+    // over slots whose owner process has exited
+    bool open(const char* name = SHARED_VEHICLE_DEFAULT_NAME);
+    // Withdraws this writer's fields and frees its slot
+    void close();
+    bool isOpen() const { return block != nullptr; }
+
+    void set(VehicleField field, float value);
+    void clear(VehicleField field);
+
+    // Make the staged values visible to readers
+    void publish();
+
+private:
+    SharedVehicleBlock* block;
+    SharedVehicleSlot* slot;
+    SharedVehiclePayload staged;
+};
+
+// The cluster side: polls the block once per frame and keeps the last
+// consistent copy of each slot. A field driven by more than one writer
+// takes its value from the lowest-numbered slot.
+class SharedVehicleReader {
+public:
+    // Torn reads are retried this many times before the frame keeps the old copy
+    static const int MaxReadAttempts = 4;
+
+    SharedVehicleReader();
+    ~SharedVehicleReader();
+
+    SharedVehicleReader(const SharedVehicleReader&) = delete;
+    SharedVehicleReader& operator=(const SharedVehicleReader&) = delete;
+
+    // Create or attach, so the cluster and writers can start in any order
+    bool open(const char* name = SHARED_VEHICLE_DEFAULT_NAME);
+    void close();
+    bool isOpen() const { return block != nullptr; }
+
+    // Copy the slots writers published to since the last call; true when the
+    // merged values changed. Never blocks on a writer.
+    bool poll();
+
+    // The newest consistent values of all writers, as a state and the fields
+    // it drives
+    const VehicleState& state() const { return latest; }
+    uint32_t fields() const { return latestFields; }
+    uint32_t generation() const { return latestGeneration; }
+
+private:
+    bool pollSlot(int index);
+
+    SharedVehicleBlock* block;
+    uint32_t lastSequence[SHARED_VEHICLE_MAX_WRITERS];
+    SharedVehiclePayload slotPayloads[SHARED_VEHICLE_MAX_WRITERS];
+    VehicleState latest;
+    uint32_t latestFields;
+    uint32_t latestGeneration;
+};
+
+#endif
@@ -0,0 +1,69 @@
+#include "SignalBus.h"
+
+SignalBus::SignalBus() : committedVersion(0), pendingVersion(1) {
+    // Every channel starts changed, so a new reader draws everything once
+    for (int i = 0; i < CHANNEL_COUNT; i++) {
+        values[i].store(0, std::memory_order_relaxed);
+        versions[i].store(1, std::memory_order_relaxed);
+    }
+}
+
+void SignalBus::setBits(SignalChannel channel, uint32_t bits) {
+    if (values[channel].load(std::memory_order_relaxed) == bits)
+        return;
+    values[channel].store(bits, std::memory_order_release);
+    versions[channel].store(pendingVersion, std::memory_order_release);
+}
+
+void SignalBus::commit() {
+    committedVersion.store(pendingVersion, std::memory_order_release);
+    pendingVersion++;
+}
+
+void SignalBus::publish(const VehicleState& vehicle, uint64_t warnings) {
+    uint32_t indicators = 0;
+    auto indicator = [&indicators](IndicatorBit bit, bool on) {
+        if (on) indicators |= 1u << bit;
+    };
+    indicator(INDICATOR_ENGINE_RUNNING, vehicle.engineRunning);
+    indicator(INDICATOR_TURN_LEFT, vehicle.turnSignalLeft);
+    indicator(INDICATOR_TURN_RIGHT, vehicle.turnSignalRight);
+    indicator(INDICATOR_HAZARDS, vehicle.hazardsOn);
+    indicator(INDICATOR_LIGHTS, vehicle.lightsOn);
+    indicator(INDICATOR_PARKING_BRAKE, vehicle.parkingBrake);
+    indicator(INDICATOR_SEATBELT, vehicle.seatbelt);
+    indicator(INDICATOR_AC, vehicle.acOn);
+
+    set(Signals::Speed, vehicle.speed);
+    set(Signals::Rpm, vehicle.rpm);
+    set(Signals::Fuel, vehicle.fuel);
+    set(Signals::EngineTemp, vehicle.engineTemp);
+    set(Signals::TempMin, vehicle.minTemp);
+    set(Signals::TempMax, vehicle.maxTemp);
+    set(Signals::OilPressure, vehicle.oilPressure);
+    set(Signals::BatteryVoltage, vehicle.batteryVoltage);
+    set(Signals::OutsideTemp, vehicle.outsideTemp);
+    set(Signals::Indicators, indicators);
+    set(Signals::Warnings, (uint32_t)warnings);
+    set(Signals::DisplayMode, (int32_t)vehicle.displayMode);
+    set(Signals::Gear, (int32_t)vehicle.gear);
+    commit();
+}
+
+uint32_t SignalBus::changedSince(uint64_t seenVersion) const {
+    uint32_t changed = 0;
+    for (int i = 0; i < CHANNEL_COUNT; i++) {
+        if (versions[i].load(std::memory_order_acquire) > seenVersion)
+            changed |= 1u << i;
+    }
+    return changed;
+}
+
+uint32_t SignalBus::takeChanges(uint64_t& seenVersion) const {
+    // Read the version first: a commit landing in between is reported now
+    // and, because the saved version predates it, again next time
+    uint64_t newest = version();
+    uint32_t changed = changedSince(seenVersion);
+    seenVersion = newest;
+    return changed;
+}
@@ -0,0 +1,132 @@
+#ifndef SIGNAL_BUS_H
+#define SIGNAL_BUS_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "Vehicle.h"
+
+// Every value the cluster displays, one channel each. A channel's bit in a
+// changed mask is its index.
+enum SignalChannel {
+    CHANNEL_SPEED,
+    CHANNEL_RPM,
+    CHANNEL_FUEL,
+    CHANNEL_ENGINE_TEMP,
+    CHANNEL_TEMP_MIN,
+    CHANNEL_TEMP_MAX,
+    CHANNEL_OIL_PRESSURE,
+    CHANNEL_BATTERY_VOLTAGE,
+    CHANNEL_OUTSIDE_TEMP,
+    CHANNEL_INDICATORS,
+    CHANNEL_WARNINGS,
+    CHANNEL_DISPLAY_MODE,
+    CHANNEL_GEAR,
+    CHANNEL_COUNT
+};
+
+static_assert(CHANNEL_COUNT <= 32, "Changed masks hold 32 channels");
+static_assert(WARN_COUNT <= 32, "The warnings channel holds 32 tell-tales");
+
+// Bits of the indicators channel
+enum IndicatorBit {
+    INDICATOR_ENGINE_RUNNING,
+    INDICATOR_TURN_LEFT,
+    INDICATOR_TURN_RIGHT,
+    INDICATOR_HAZARDS,
+    INDICATOR_LIGHTS,
+    INDICATOR_PARKING_BRAKE,
+    INDICATOR_SEATBELT,
+    INDICATOR_AC
+};
+
+// A channel together with the type of its value
+template <class T>
+struct Signal {
+    SignalChannel channel;
+};
+
+namespace Signals {
+    constexpr Signal<float> Speed = { CHANNEL_SPEED };               // km/h
+    constexpr Signal<float> Rpm = { CHANNEL_RPM };
+    constexpr Signal<float> Fuel = { CHANNEL_FUEL };                 // Percent
+    constexpr Signal<float> EngineTemp = { CHANNEL_ENGINE_TEMP };    // Degrees C
+    constexpr Signal<float> TempMin = { CHANNEL_TEMP_MIN };          // Temperature gauge range
+    constexpr Signal<float> TempMax = { CHANNEL_TEMP_MAX };
+    constexpr Signal<float> OilPressure = { CHANNEL_OIL_PRESSURE };  // PSI
+    constexpr Signal<float> BatteryVoltage = { CHANNEL_BATTERY_VOLTAGE };
+    constexpr Signal<float> OutsideTemp = { CHANNEL_OUTSIDE_TEMP };  // Degrees C
+    constexpr Signal<uint32_t> Indicators = { CHANNEL_INDICATORS };  // IndicatorBit mask
+    constexpr Signal<uint32_t> Warnings = { CHANNEL_WARNINGS };      // WarningLightIndex mask
+    constexpr Signal<int32_t> DisplayMode = { CHANNEL_DISPLAY_MODE };
+    constexpr Signal<int32_t> Gear = { CHANNEL_GEAR };
+}
+
+// The displayed values as typed, versioned channels. One thread writes, any
+// number of threads read, and neither side takes a lock.
+//
+// The writer sets channels, then commits them as the next bus version; a set
+// that does not change a value leaves its channel's version alone. A reader
+// keeps the bus version it last saw and asks which channels changed since,
+// so a widget whose channels did not change can skip its work:
+//
+//   uint32_t changed = bus.takeChanges(seenVersion);
+//   if (changed & (1u << CHANNEL_SPEED)) ...bus.get(Signals::Speed)...
+//
+// Values are read one channel at a time; a reader racing a commit may see
+// some of its channels early, and is told about them again next time.
+class SignalBus {
+public:
+    SignalBus();
+
+    SignalBus(const SignalBus&) = delete;
+    SignalBus& operator=(const SignalBus&) = delete;
+
+    // Writer side
+    template <class T>
+    void set(Signal<T> signal, T value) {
+        static_assert(sizeof(T) == sizeof(uint32_t) && std::is_trivially_copyable<T>::value,
+                      "Channels hold 32-bit values");
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        setBits(signal.channel, bits);
+    }
+
+    // Set every channel from a vehicle state and its active tell-tales, then commit
+    void publish(const VehicleState& vehicle, uint64_t warnings);
+
+    // Make the channels set since the last commit part of the next version
+    void commit();
+
+    // Reader side
+    template <class T>
+    T get(Signal<T> signal) const {
+        uint32_t bits = values[signal.channel].load(std::memory_order_acquire);
+        T value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    // The newest committed version; 0 before the first commit
+    uint64_t version() const { return committedVersion.load(std::memory_order_acquire); }
+    uint64_t channelVersion(SignalChannel channel) const {
+        return versions[channel].load(std::memory_order_acquire);
+    }
+
+    // Channels changed after a version a reader saw
+    uint32_t changedSince(uint64_t seenVersion) const;
+    // The same, then advance the reader's version to the newest commit
+    uint32_t takeChanges(uint64_t& seenVersion) const;
+
+private:
+    void setBits(SignalChannel channel, uint32_t bits);
+
+    std::atomic<uint32_t> values[CHANNEL_COUNT];
+    std::atomic<uint64_t> versions[CHANNEL_COUNT];
+    std::atomic<uint64_t> committedVersion;
+    uint64_t pendingVersion; // Writer only: the version being assembled
+};
+
+#endif
@@ -0,0 +1,101 @@
+// Test publisher for the cluster's shared memory interface: sweeps the speed
+// and RPM needles, blinks the left turn signal and drives the engine and
+// fuel values, so a cluster started with --shm shows it moving.
+//
+// Build from the repository root with SharedVehicleState.cpp and Vehicle.cpp,
+// e.g. g++ -std=c++17 -I. Tools/SharedStatePublisher.cpp SharedVehicleState.cpp
+// Vehicle.cpp -o shared_state_publisher (older glibc also needs -lrt).
+
+#include <chrono>
+#include <cmath>
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "../SharedVehicleState.h"
+
+static volatile std::sig_atomic_t stopRequested = 0;
+
+static void requestStop(int) {
+    stopRequested = 1;
+}
+
+static void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " [options]\n";
+    std::cout << "  --name NAME     Shared memory object (default " << SHARED_VEHICLE_DEFAULT_NAME << ")\n";
+    std::cout << "  --rate HZ       Updates per second (default 100)\n";
+    std::cout << "  --seconds S     Stop after S seconds (default: run until interrupted)\n";
+    std::cout << "  --help          Show this message\n";
+}
+
+int main(int argc, char** argv) {
+    const char* name = SHARED_VEHICLE_DEFAULT_NAME;
+    double rate = 100.0;
+    double seconds = 0.0;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--name" && i + 1 < argc) {
+            name = argv[++i];
+        }
+        else if (arg == "--rate" && i + 1 < argc) {
+            rate = std::atof(argv[++i]);
+            if (rate <= 0.0) {
+                std::cerr << "ERROR::ARGS::INVALID_RATE: " << argv[i] << "\n";
+                return -1;
+            }
+        }
+        else if (arg == "--seconds" && i + 1 < argc) {
+            seconds = std::atof(argv[++i]);
+        }
+        else if (arg == "--help") {
+            printUsage(argv[0]);
+            return 0;
+        }
+        else {
+            std::cerr << "ERROR::ARGS::UNKNOWN_OPTION: " << arg << "\n";
+            printUsage(argv[0]);
+            return -1;
+        }
+    }
+
+    SharedVehicleWriter writer;
+    if (!writer.open(name))
+        return -1;
+    std::signal(SIGINT, requestStop);
+    std::signal(SIGTERM, requestStop);
+    std::cout << "Publishing to " << name << " at " << rate << " Hz\n";
+
+    const float pi = 3.14159265f;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point next = start;
+    std::chrono::steady_clock::duration period =
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(1.0 / rate));
+    uint64_t updates = 0;
+
+    while (!stopRequested) {
+        float t = std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count();
+        if (seconds > 0.0 && t >= seconds)
+            break;
+
+        // A 10 second sweep up and down, with RPM following the speed
+        float sweep = 0.5f - 0.5f * std::cos(2.0f * pi * t / 10.0f);
+        writer.set(FIELD_SPEED, 220.0f * sweep);
+        writer.set(FIELD_RPM, 800.0f + 5200.0f * sweep);
+        writer.set(FIELD_ENGINE_TEMP, 90.0f);
+        writer.set(FIELD_FUEL, 100.0f - std::fmod(t, 100.0f));
+        writer.set(FIELD_ENGINE_RUNNING, 1.0f);
+        writer.set(FIELD_TURN_LEFT, std::fmod(t, 1.0f) < 0.5f ? 1.0f : 0.0f);
+        writer.publish();
+        updates++;
+
+        next += period;
+        std::this_thread::sleep_until(next);
+    }
+
+    // Closing withdraws the fields, so the cluster goes back to its simulation
+    writer.close();
+    std::cout << "Published " << updates << " updates\n";
+    return 0;
+}
@@ -0,0 +1,62 @@
+#ifndef TRIPLE_BUFFER_H
+#define TRIPLE_BUFFER_H
+
+#include <atomic>
+#include <cstdint>
+
+// Wait-free handoff of whole snapshots from one producer thread to one
+// consumer thread. The producer owns one slot, the consumer another, and the
+// third sits in between holding the newest published snapshot. Publishing and
+// picking up are each a single atomic exchange, so neither side ever waits on
+// the other: a stalled producer leaves the consumer re-reading its last
+// snapshot, and a slow consumer just skips the snapshots it missed.
+template <class T>
+class TripleBuffer {
+public:
+    TripleBuffer() : writeIndex(0), middle(1), readIndex(2) {}
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    // Producer side: fill the write slot, then publish it
+    T& writeBuffer() { return slots[writeIndex].value; }
+
+    void publish() {
+        uint8_t previous = middle.exchange(writeIndex | FRESH, std::memory_order_acq_rel);
+        writeIndex = previous & INDEX_MASK;
+    }
+
+    void publish(const T& snapshot) {
+        writeBuffer() = snapshot;
+        publish();
+    }
+
+    // Consumer side: take the newest snapshot if one was published since the
+    // last call; returns false and keeps the current one otherwise
+    bool update() {
+        if (!(middle.load(std::memory_order_relaxed) & FRESH))
+            return false;
+        uint8_t previous = middle.exchange(readIndex, std::memory_order_acq_rel);
+        readIndex = previous & INDEX_MASK;
+        return true;
+    }
+
+    // Stays valid and unchanged until the next update()
+    const T& read() const { return slots[readIndex].value; }
+
+private:
+    static const uint8_t INDEX_MASK = 0x3;
+    static const uint8_t FRESH = 0x4; // Set in middle while it holds an unread snapshot
+
+    // Own cache line per slot so the two threads never share one
+    struct alignas(64) Slot {
+        T value;
+    };
+
+    Slot slots[3];
+    uint8_t writeIndex;                     // Producer only
+    alignas(64) std::atomic<uint8_t> middle;
+    alignas(64) uint8_t readIndex;          // Consumer only
+};
+
+#endif
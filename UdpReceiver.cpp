@@ -0,0 +1,246 @@
+#include "UdpReceiver.h"
+#include "IdleWake.h"
+#include "Profiler.h"
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#ifdef __linux__
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#endif
+
+static uint32_t readLittle32(const uint8_t* bytes) {
+    return (uint32_t)bytes[0] | ((uint32_t)bytes[1] << 8) | ((uint32_t)bytes[2] << 16) | ((uint32_t)bytes[3] << 24);
+}
+
+static void writeLittle32(uint8_t* bytes, uint32_t value) {
+    bytes[0] = (uint8_t)value;
+    bytes[1] = (uint8_t)(value >> 8);
+    bytes[2] = (uint8_t)(value >> 16);
+    bytes[3] = (uint8_t)(value >> 24);
+}
+
+bool UdpReceiver::decodeHeader(const uint8_t* packet, size_t length, uint32_t& fields, uint32_t& sequence) {
+    if (length != (size_t)UDP_TELEMETRY_PACKET_BYTES || readLittle32(packet) != UDP_TELEMETRY_MAGIC)
+        return false;
+    sequence = readLittle32(packet + 4);
+    fields = readLittle32(packet + 8) & ((1u << FIELD_COUNT) - 1);
+    return true;
+}
+
+void UdpReceiver::applyValues(const uint8_t* packet, uint32_t fields, VehicleState& vehicle) {
+    for (int field = 0; field < FIELD_COUNT; field++) {
+        if (!((fields >> field) & 1u))
+            continue;
+        uint32_t bits = readLittle32(packet + 12 + 4 * field);
+        float value;
+        memcpy(&value, &bits, sizeof(value));
+        setVehicleField(vehicle, (VehicleField)field, value);
+    }
+}
+
+void UdpReceiver::encode(uint32_t sequence, uint32_t fields, const float values[UDP_TELEMETRY_SLOTS],
+                         uint8_t packet[UDP_TELEMETRY_PACKET_BYTES]) {
+    writeLittle32(packet, UDP_TELEMETRY_MAGIC);
+    writeLittle32(packet + 4, sequence);
+    writeLittle32(packet + 8, fields);
+    for (int i = 0; i < UDP_TELEMETRY_SLOTS; i++) {
+        uint32_t bits;
+        memcpy(&bits, &values[i], sizeof(bits));
+        writeLittle32(packet + 12 + 4 * i, bits);
+    }
+}
+
+UdpReceiver::UdpReceiver()
+    : socketFd(-1), idleWake(nullptr), received(0), rejected(0), lost(0), late(0), stopRequested(false)
+{
+    UdpSnapshot& initial = snapshots.writeBuffer();
+    initial.fields = 0;
+    initial.packets = 0;
+    snapshots.publish();
+    snapshots.update();
+}
+
+UdpReceiver::~UdpReceiver() {
+    stop();
+#ifdef __linux__
+    if (socketFd >= 0)
+        close(socketFd);
+#endif
+}
+
+void UdpReceiver::start(IdleWake* wake) {
+    if (!isOpen() || thread.joinable())
+        return;
+    idleWake = wake;
+    stopRequested.store(false, std::memory_order_relaxed);
+    thread = std::thread(&UdpReceiver::run, this);
+}
+
+void UdpReceiver::stop() {
+    if (!thread.joinable())
+        return;
+    stopRequested.store(true, std::memory_order_relaxed);
+    thread.join();
+}
+
+#ifdef __linux__
+
+bool UdpReceiver::open(const char* endpoint) {
+    if (isOpen())
+        return true;
+
+    sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    std::string text = endpoint;
+    size_t colon = text.rfind(':');
+    if (colon != std::string::npos &&
+        inet_pton(AF_INET, text.substr(0, colon).c_str(), &address.sin_addr) != 1) {
+        std::cerr << "ERROR::UDP::INVALID_ADDRESS: " << endpoint << "\n";
+        return false;
+    }
+    int port = std::atoi(text.c_str() + (colon == std::string::npos ? 0 : colon + 1));
+    if (port <= 0 || port > 65535) {
+        std::cerr << "ERROR::UDP::INVALID_PORT: " << endpoint << "\n";
+        return false;
+    }
+    address.sin_port = htons((uint16_t)port);
+
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd < 0) {
+        std::cerr << "ERROR::UDP::SOCKET_FAILED: " << strerror(errno) << "\n";
+        return false;
+    }
+
+    // Bounded wait so the thread notices stop(); shared with other listeners
+    // on the rig's port; a larger buffer than the default for bursts
+    timeval timeout = { 0, 100000 };
+    int enable = 1;
+    int bufferBytes = ReceiveBufferBytes;
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+    setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &bufferBytes, sizeof(bufferBytes));
+
+    if (bind(fd, (sockaddr*)&address, sizeof(address)) < 0) {
+        std::cerr << "ERROR::UDP::BIND_FAILED: " << endpoint << ": " << strerror(errno) << "\n";
+        close(fd);
+        return false;
+    }
+
+    socketFd = fd;
+    return true;
+}
+
+void UdpReceiver::run() {
+    // One byte of slack, so oversized datagrams show up as the wrong length
+    // instead of being truncated to a valid one
+    uint8_t packets[BatchSize][UDP_TELEMETRY_PACKET_BYTES + 1];
+    iovec buffers[BatchSize];
+    mmsghdr messages[BatchSize];
+
+    memset(messages, 0, sizeof(messages));
+    for (int i = 0; i < BatchSize; i++) {
+        buffers[i].iov_base = packets[i];
+        buffers[i].iov_len = sizeof(packets[i]);
+        messages[i].msg_hdr.msg_iov = &buffers[i];
+        messages[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    VehicleState state;
+    uint32_t fields = 0;
+    uint64_t packetCount = 0;
+    uint64_t rejectedCount = 0;
+    uint64_t lostCount = 0;
+    uint64_t lateCount = 0;
+    uint32_t expectedSequence = 0;
+    bool sequenceKnown = false;
+    // Bit k is set once expectedSequence - 1 - k has arrived
+    uint64_t arrivedWindow = 0;
+
+    while (!stopRequested.load(std::memory_order_relaxed)) {
+        // Blocks for the first packet only, then takes whatever else is queued
+        int count = recvmmsg(socketFd, messages, BatchSize, MSG_WAITFORONE, nullptr);
+        if (count < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+                continue;
+            std::cerr << "ERROR::UDP::RECEIVE_FAILED: " << strerror(errno) << "\n";
+            break;
+        }
+
+        PROFILE_ZONE("UdpReceiver::batch");
+        VehicleState before = state;
+        uint32_t fieldsBefore = fields;
+        for (int i = 0; i < count; i++) {
+            uint32_t packetFields, sequence;
+            if (!decodeHeader(packets[i], messages[i].msg_len, packetFields, sequence)) {
+                rejectedCount++;
+                continue;
+            }
+
+            // Forward jumps are lost packets. A short jump back is a reordered
+            // or duplicated packet whose values are older than ours, so it is
+            // dropped; only a long one means the sender restarted.
+            int32_t gap = (int32_t)(sequence - expectedSequence);
+            if (sequenceKnown && gap < 0 && gap > -RestartGap) {
+                lateCount++;
+                // A reordered packet was counted lost when the sequence jumped
+                // past it; a duplicate was not. Past the 64-packet window they
+                // cannot be told apart, so a late packet there counts as reordered.
+                uint32_t behind = (uint32_t)(-gap - 1);
+                uint64_t bit = behind < 64 ? 1ull << behind : 0;
+                if (bit == 0 || !(arrivedWindow & bit)) {
+                    arrivedWindow |= bit;
+                    if (lostCount > 0)
+                        lostCount--;
+                }
+                continue;
+            }
+            if (sequenceKnown && gap > 0)
+                lostCount += (uint32_t)gap;
+            uint32_t shift = sequenceKnown && gap >= 0 ? (uint32_t)gap + 1 : 64;
+            arrivedWindow = (shift < 64 ? arrivedWindow << shift : 0) | 1;
+            expectedSequence = sequence + 1;
+            sequenceKnown = true;
+
+            applyValues(packets[i], packetFields, state);
+            fields |= packetFields;
+        }
+        packetCount += count;
+        received.store(packetCount, std::memory_order_relaxed);
+        rejected.store(rejectedCount, std::memory_order_relaxed);
+        lost.store(lostCount, std::memory_order_relaxed);
+        late.store(lateCount, std::memory_order_relaxed);
+
+        // However many packets the batch held, it is published once
+        if (fields == fieldsBefore && state == before)
+            continue;
+
+        UdpSnapshot& snapshot = snapshots.writeBuffer();
+        snapshot.state = state;
+        snapshot.fields = fields;
+        snapshot.packets = packetCount;
+        snapshots.publish();
+        if (idleWake)
+            idleWake->notify();
+    }
+}
+
+#else
+
+bool UdpReceiver::open(const char* endpoint) {
+    std::cerr << "ERROR::UDP::UNSUPPORTED_PLATFORM: recvmmsg needs Linux\n";
+    return false;
+}
+
+void UdpReceiver::run() {}
+
+#endif
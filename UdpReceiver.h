@@ -0,0 +1,99 @@
+#ifndef UDP_RECEIVER_H
+#define UDP_RECEIVER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+#include "TripleBuffer.h"
+#include "Vehicle.h"
+
+class IdleWake; // Forward declaration
+
+// The telemetry datagram, all fields little-endian:
+//   bytes  0-3   magic "CLUT"
+//   bytes  4-7   sequence number, incremented by the sender per packet
+//   bytes  8-11  VehicleField mask of the values this packet carries
+//   bytes 12-75  16 float slots, one per VehicleField; unused slots are ignored
+// Switch fields are on for any non-zero value.
+const uint32_t UDP_TELEMETRY_MAGIC = 0x54554c43; // "CLUT"
+const int UDP_TELEMETRY_SLOTS = 16;
+const int UDP_TELEMETRY_PACKET_BYTES = 12 + 4 * UDP_TELEMETRY_SLOTS;
+
+static_assert(FIELD_COUNT <= UDP_TELEMETRY_SLOTS, "Telemetry packet holds 16 fields");
+
+// Everything received so far, coalesced: the newest value of each field
+struct UdpSnapshot {
+    VehicleState state;
+    uint32_t fields;
+    uint64_t packets;
+};
+
+// Receives telemetry datagrams on a UDP port on its own thread. Packets are
+// drained with recvmmsg in batches and folded into one state, so however many
+// arrive between frames the renderer picks up only the newest value of each
+// field through a triple buffer. Linux only; elsewhere open() fails.
+class UdpReceiver {
+public:
+    static const int BatchSize = 64;
+    // Requested socket receive buffer; at 50k packets/s it holds ~100 ms
+    static const int ReceiveBufferBytes = 4 << 20;
+    // A sequence this far behind the expected one is a restarted sender,
+    // anything closer a late packet
+    static const int32_t RestartGap = 1024;
+
+    UdpReceiver();
+    ~UdpReceiver();
+
+    UdpReceiver(const UdpReceiver&) = delete;
+    UdpReceiver& operator=(const UdpReceiver&) = delete;
+
+    // "PORT" or "ADDRESS:PORT"; the address defaults to any, so broadcasts
+    // and loopback both arrive
+    bool open(const char* endpoint);
+    bool isOpen() const { return socketFd >= 0; }
+
+    // The wake is notified after every batch that changed a field
+    void start(IdleWake* wake);
+    void stop();
+
+    // Renderer side
+    bool update() { return snapshots.update(); }
+    const UdpSnapshot& latest() const { return snapshots.read(); }
+
+    uint64_t packetsReceived() const { return received.load(std::memory_order_relaxed); }
+    // Datagrams of the wrong size or magic
+    uint64_t packetsRejected() const { return rejected.load(std::memory_order_relaxed); }
+    // Gaps in the sender's sequence numbers: lost on the way or dropped by the
+    // kernel. A gap filled later by a reordered packet is no longer counted.
+    uint64_t packetsLost() const { return lost.load(std::memory_order_relaxed); }
+    // Reordered or duplicated packets, dropped because newer values were applied
+    uint64_t packetsLate() const { return late.load(std::memory_order_relaxed); }
+
+    // Read one datagram's sequence number and field mask; false if it is not
+    // a telemetry packet
+    static bool decodeHeader(const uint8_t* packet, size_t length, uint32_t& fields, uint32_t& sequence);
+    // Apply the values of a datagram that passed decodeHeader
+    static void applyValues(const uint8_t* packet, uint32_t fields, VehicleState& vehicle);
+    // Build one datagram from a value per field; for senders and tests
+    static void encode(uint32_t sequence, uint32_t fields, const float values[UDP_TELEMETRY_SLOTS],
+                       uint8_t packet[UDP_TELEMETRY_PACKET_BYTES]);
+
+private:
+    void run();
+
+    int socketFd;
+    IdleWake* idleWake;
+
+    TripleBuffer<UdpSnapshot> snapshots;
+
+    std::atomic<uint64_t> received;
+    std::atomic<uint64_t> rejected;
+    std::atomic<uint64_t> lost;
+    std::atomic<uint64_t> late;
+    std::atomic<bool> stopRequested;
+    std::thread thread;
+};
+
+#endif
@@ -0,0 +1,92 @@
+#include "UniformBlocks.h"
+#include "Shader.h"
+#include "Profiler.h"
+#include <cstring>
+
+FrameUniforms::FrameUniforms() : UBO(0) {
+    glGenBuffers(1, &UBO);
+    glBindBuffer(GL_UNIFORM_BUFFER, UBO);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(FrameParams), NULL, GL_DYNAMIC_DRAW);
+    glBindBufferBase(GL_UNIFORM_BUFFER, FRAME_BLOCK_BINDING, UBO);
+}
+
+FrameUniforms::~FrameUniforms() {
+    glDeleteBuffers(1, &UBO);
+}
+
+void FrameUniforms::update(const FrameParams& params) {
+    glBindBuffer(GL_UNIFORM_BUFFER, UBO);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(FrameParams), &params);
+    glBindBufferBase(GL_UNIFORM_BUFFER, FRAME_BLOCK_BINDING, UBO);
+}
+
+DrawQueue::DrawQueue(size_t initialCapacity)
+    : UBO(0), stride(0), capacity(0)
+{
+    GLint alignment = 256;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    if (alignment <= 0) alignment = 256;
+    stride = (sizeof(DrawParams) + alignment - 1) / alignment * alignment;
+
+    glGenBuffers(1, &UBO);
+    reserveGPU(initialCapacity);
+    commands.reserve(initialCapacity);
+    records.reserve(initialCapacity * stride);
+}
+
+DrawQueue::~DrawQueue() {
+    glDeleteBuffers(1, &UBO);
+}
+
+void DrawQueue::reserveGPU(size_t count) {
+    glBindBuffer(GL_UNIFORM_BUFFER, UBO);
+    glBufferData(GL_UNIFORM_BUFFER, count * stride, NULL, GL_STREAM_DRAW);
+    capacity = count;
+}
+
+void DrawQueue::push(GLuint vao, GLenum mode, GLint first, GLsizei count, const DrawParams& params, GLuint texture) {
+    size_t offset = records.size();
+    records.resize(offset + stride);
+    std::memcpy(&records[offset], &params, sizeof(DrawParams));
+    commands.push_back({ vao, mode, first, count, texture });
+}
+
+void DrawQueue::flush(const Shader& shader) {
+    PROFILE_ZONE("DrawQueue::flush");
+    if (commands.empty())
+        return;
+
+    // Only grows when a frame records more draws than ever before
+    if (commands.size() > capacity) {
+        size_t newCapacity = capacity > 0 ? capacity * 2 : 32;
+        while (newCapacity < commands.size()) newCapacity *= 2;
+        reserveGPU(newCapacity);
+    }
+
+    shader.use();
+
+    // Orphan last frame's records, then upload this frame's in one go
+    glBindBuffer(GL_UNIFORM_BUFFER, UBO);
+    glBufferData(GL_UNIFORM_BUFFER, capacity * stride, NULL, GL_STREAM_DRAW);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, records.size(), records.data());
+
+    GLuint boundVAO = 0;
+    GLuint boundTexture = 0;
+    for (size_t i = 0; i < commands.size(); i++) {
+        const DrawCommand& cmd = commands[i];
+        glBindBufferRange(GL_UNIFORM_BUFFER, DRAW_BLOCK_BINDING, UBO, (GLintptr)(i * stride), sizeof(DrawParams));
+        if (cmd.vao != boundVAO) {
+            glBindVertexArray(cmd.vao);
+            boundVAO = cmd.vao;
+        }
+        if (cmd.texture != 0 && cmd.texture != boundTexture) {
+            glActiveTexture(GL_TEXTURE0);
+            glBindTexture(GL_TEXTURE_2D, cmd.texture);
+            boundTexture = cmd.texture;
+        }
+        glDrawArrays(cmd.mode, cmd.first, cmd.count);
+    }
+
+    commands.clear();
+    records.clear();
+}
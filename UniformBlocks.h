@@ -0,0 +1,102 @@
+#ifndef UNIFORM_BLOCKS_H
+#define UNIFORM_BLOCKS_H
+
+#include <glad/glad.h>
+#include <cstddef>
+#include <vector>
+
+class Shader; // Forward declaration
+
+// Binding points shared by every program that declares the blocks
+enum UniformBinding : GLuint {
+    FRAME_BLOCK_BINDING = 0,
+    DRAW_BLOCK_BINDING = 1,
+    SDF_BLOCK_BINDING = 2
+};
+
+// std140 mirror of:
+//   layout(std140) uniform FrameBlock { vec2 resolution; vec2 viewExtent; float time; int mode; };
+struct FrameParams {
+    float resolution[2];  // Framebuffer size in pixels
+    float viewExtent[2];  // Cluster units that map to the edge of clip space
+    float time;           // Seconds since start-up
+    int mode;             // Vehicle display mode
+    float pad[2];
+};
+
+// std140 mirror of:
+//   layout(std140) uniform DrawBlock { vec2 offset; vec2 scale; vec3 color; float alpha; float rotation; float textured; };
+struct DrawParams {
+    float offset[2];
+    float scale[2];
+    float color[3];
+    float alpha;
+    float rotation;
+    float textured;   // 1 samples the bound texture (premultiplied) instead of color
+    float pad[2];
+};
+
+static_assert(sizeof(FrameParams) == 32, "FrameParams must match the std140 FrameBlock layout");
+static_assert(sizeof(DrawParams) == 48, "DrawParams must match the std140 DrawBlock layout");
+
+inline DrawParams makeDrawParams(float offsetX, float offsetY, float scaleX, float scaleY, float rotation,
+                                 float r, float g, float b, float alpha = 1.0f) {
+    DrawParams params = {};
+    params.offset[0] = offsetX;
+    params.offset[1] = offsetY;
+    params.scale[0] = scaleX;
+    params.scale[1] = scaleY;
+    params.color[0] = r;
+    params.color[1] = g;
+    params.color[2] = b;
+    params.alpha = alpha;
+    params.rotation = rotation;
+    return params;
+}
+
+// Frame-level uniform buffer, updated once per frame and bound for the whole frame
+class FrameUniforms {
+public:
+    FrameUniforms();
+    ~FrameUniforms();
+
+    void update(const FrameParams& params);
+
+private:
+    GLuint UBO;
+};
+
+// Records draws with their DrawParams, then uploads every record in one
+// buffer update and issues each draw with a single glBindBufferRange.
+class DrawQueue {
+public:
+    explicit DrawQueue(size_t initialCapacity = 32);
+    ~DrawQueue();
+
+    void push(GLuint vao, GLenum mode, GLint first, GLsizei count, const DrawParams& params, GLuint texture = 0);
+
+    // Upload the queued records and draw them in submission order
+    void flush(const Shader& shader);
+
+    size_t size() const { return commands.size(); }
+
+private:
+    struct DrawCommand {
+        GLuint vao;
+        GLenum mode;
+        GLint first;
+        GLsizei count;
+        GLuint texture;
+    };
+
+    void reserveGPU(size_t records);
+
+    GLuint UBO;
+    size_t stride;   // sizeof(DrawParams) rounded up to the UBO offset alignment
+    size_t capacity; // records the UBO can currently hold
+
+    std::vector<DrawCommand> commands;
+    std::vector<unsigned char> records;
+};
+
+#endif
@@ -0,0 +1,243 @@
+#include "Vehicle.h"
+#include <algorithm>
+#include <cmath>
+#include <cctype>
+
+bool operator==(const VehicleState& a, const VehicleState& b) {
+    return a.speed == b.speed && a.rpm == b.rpm && a.fuel == b.fuel &&
+           a.engineTemp == b.engineTemp && a.oilPressure == b.oilPressure &&
+           a.batteryVoltage == b.batteryVoltage && a.engineRunning == b.engineRunning &&
+           a.acOn == b.acOn && a.lightsOn == b.lightsOn &&
+           a.turnSignalLeft == b.turnSignalLeft && a.turnSignalRight == b.turnSignalRight &&
+           a.hazardsOn == b.hazardsOn && a.parkingBrake == b.parkingBrake && a.seatbelt == b.seatbelt &&
+           a.doors[0] == b.doors[0] && a.doors[1] == b.doors[1] &&
+           a.doors[2] == b.doors[2] && a.doors[3] == b.doors[3] &&
+           a.gear == b.gear && a.displayMode == b.displayMode && a.odometer == b.odometer &&
+           a.tripA == b.tripA && a.tripB == b.tripB && a.avgFuelConsumption == b.avgFuelConsumption &&
+           a.outsideTemp == b.outsideTemp && a.timeHour == b.timeHour && a.timeMinute == b.timeMinute &&
+           a.throttlePressed == b.throttlePressed && a.targetSpeed == b.targetSpeed &&
+           a.targetRPM == b.targetRPM && a.minTemp == b.minTemp && a.maxTemp == b.maxTemp;
+}
+
+bool operator!=(const VehicleState& a, const VehicleState& b) {
+    return !(a == b);
+}
+
+void updateVehicle(VehicleState& vehicle, const InputFrame& input) {
+    float deltaTime = input.deltaTime;
+
+    // Throttle control
+    bool currentThrottle = input.isHeld(ACTION_THROTTLE);
+    vehicle.throttlePressed = currentThrottle;
+
+    // Update vehicle speed and RPM based on throttle input
+    if (currentThrottle && vehicle.engineRunning) {
+        // Increase the speed by 50 * deltaTime, but don't go past 250 (speed cap).
+        vehicle.targetSpeed = std::min(vehicle.targetSpeed + 50.0f * deltaTime, 250.0f);
+        // Increase the RPM by 2000 * deltaTime, but don't go past 7000 (RPM cap).
+        vehicle.targetRPM = std::min(vehicle.targetRPM + 2000.0f * deltaTime, 7000.0f);
+    }
+    else {
+        // If throttle is not pressed, decrease speed and RPM
+        vehicle.targetSpeed = std::max(vehicle.targetSpeed - 30.0f * deltaTime, 0.0f);
+        if (vehicle.engineRunning) {
+            vehicle.targetRPM = std::max(vehicle.targetRPM - 1500.0f * deltaTime, 800.0f);
+        }
+        else {
+            vehicle.targetRPM = 0.0f;
+        }
+    }
+
+    // Smooth transitions
+    vehicle.speed += (vehicle.targetSpeed - vehicle.speed) * 5.0f * deltaTime;
+    vehicle.rpm += (vehicle.targetRPM - vehicle.rpm) * 3.0f * deltaTime;
+
+    // Settle onto the targets so a parked vehicle reaches a steady state
+    if (std::fabs(vehicle.targetSpeed - vehicle.speed) < 0.01f) vehicle.speed = vehicle.targetSpeed;
+    if (std::fabs(vehicle.targetRPM - vehicle.rpm) < 1.0f) vehicle.rpm = vehicle.targetRPM;
+
+    // Mode switching
+    if (input.wasPressed(ACTION_MODE_PREVIOUS)) {
+        vehicle.displayMode = (vehicle.displayMode - 1 + 4) % 4;
+    }
+    if (input.wasPressed(ACTION_MODE_NEXT)) {
+        vehicle.displayMode = (vehicle.displayMode + 1) % 4;
+    }
+
+    // Engine start/stop
+    if (input.wasPressed(ACTION_ENGINE)) {
+        vehicle.engineRunning = !vehicle.engineRunning;
+        if (!vehicle.engineRunning) {
+            vehicle.targetRPM = 0.0f;
+            vehicle.targetSpeed = 0.0f;
+        }
+        else {
+            vehicle.targetRPM = 800.0f;
+        }
+    }
+
+    // AC toggle
+    if (input.wasPressed(ACTION_AC)) {
+        vehicle.acOn = !vehicle.acOn;
+    }
+
+    // Lights toggle
+    if (input.wasPressed(ACTION_LIGHTS)) {
+        vehicle.lightsOn = !vehicle.lightsOn;
+    }
+
+    // Turn signals
+    if (input.wasPressed(ACTION_TURN_LEFT)) {
+        vehicle.turnSignalLeft = !vehicle.turnSignalLeft;
+        if (vehicle.turnSignalLeft) vehicle.turnSignalRight = false;
+    }
+    if (input.wasPressed(ACTION_TURN_RIGHT)) {
+        vehicle.turnSignalRight = !vehicle.turnSignalRight;
+        if (vehicle.turnSignalRight) vehicle.turnSignalLeft = false;
+    }
+
+    // Hazards
+    if (input.wasPressed(ACTION_HAZARDS)) {
+        vehicle.hazardsOn = !vehicle.hazardsOn;
+        if (vehicle.hazardsOn) {
+            vehicle.turnSignalLeft = false;
+            vehicle.turnSignalRight = false;
+        }
+    }
+
+    // Parking brake
+    if (input.wasPressed(ACTION_PARKING_BRAKE)) {
+        vehicle.parkingBrake = !vehicle.parkingBrake;
+    }
+
+    // Seatbelt
+    if (input.wasPressed(ACTION_SEATBELT)) {
+        vehicle.seatbelt = !vehicle.seatbelt;
+    }
+
+    // Simulate fuel consumption
+    if (vehicle.engineRunning && vehicle.speed > 0) {
+        vehicle.fuel -= 0.5f * deltaTime * (vehicle.speed / 100.0f);
+        vehicle.fuel = std::max(vehicle.fuel, 0.0f);
+
+        vehicle.tripA += vehicle.speed * deltaTime / 3600.0f; // km/h to km
+    }
+
+    // Engine temperature simulation
+    float targetTemp = 20.0f;
+    if (vehicle.engineRunning) {
+        targetTemp = 90.0f + (vehicle.rpm - 800.0f) / 100.0f;
+        vehicle.engineTemp += (targetTemp - vehicle.engineTemp) * 0.5f * deltaTime;
+    }
+    else {
+        vehicle.engineTemp += (targetTemp - vehicle.engineTemp) * 0.1f * deltaTime;
+    }
+    if (std::fabs(targetTemp - vehicle.engineTemp) < 0.05f) vehicle.engineTemp = targetTemp;
+}
+
+VehicleState interpolateVehicle(const VehicleState& from, const VehicleState& to, float t) {
+    // The ends are returned as they are, so a steady state compares equal to itself
+    if (t <= 0.0f) return from;
+    if (t >= 1.0f) return to;
+
+    auto lerp = [t](float a, float b) { return a + (b - a) * t; };
+    VehicleState v = to;
+    v.speed = lerp(from.speed, to.speed);
+    v.rpm = lerp(from.rpm, to.rpm);
+    v.fuel = lerp(from.fuel, to.fuel);
+    v.engineTemp = lerp(from.engineTemp, to.engineTemp);
+    v.oilPressure = lerp(from.oilPressure, to.oilPressure);
+    v.batteryVoltage = lerp(from.batteryVoltage, to.batteryVoltage);
+    v.odometer = lerp(from.odometer, to.odometer);
+    v.tripA = lerp(from.tripA, to.tripA);
+    v.tripB = lerp(from.tripB, to.tripB);
+    v.avgFuelConsumption = lerp(from.avgFuelConsumption, to.avgFuelConsumption);
+    v.outsideTemp = lerp(from.outsideTemp, to.outsideTemp);
+    return v;
+}
+
+static const char* fieldNames[FIELD_COUNT] = {
+    "speed", "rpm", "fuel", "engineTemp", "oilPressure", "batteryVoltage", "engineRunning",
+    "turnLeft", "turnRight", "hazards", "lights", "parkingBrake", "seatbelt", "ac"
+};
+
+const char* vehicleFieldName(VehicleField field) {
+    return field >= 0 && field < FIELD_COUNT ? fieldNames[field] : "";
+}
+
+// Case-insensitive, so "EngineTemp" and "engineTemp" both match
+bool vehicleFieldFromName(const char* name, VehicleField& field) {
+    for (int i = 0; i < FIELD_COUNT; i++) {
+        const char* a = fieldNames[i];
+        const char* b = name;
+        while (*a && std::tolower((unsigned char)*a) == std::tolower((unsigned char)*b)) {
+            a++;
+            b++;
+        }
+        if (*a == 0 && *b == 0) {
+            field = (VehicleField)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+void setVehicleField(VehicleState& vehicle, VehicleField field, float value) {
+    bool on = value != 0.0f;
+    switch (field) {
+        case FIELD_SPEED: vehicle.speed = value; break;
+        case FIELD_RPM: vehicle.rpm = value; break;
+        case FIELD_FUEL: vehicle.fuel = value; break;
+        case FIELD_ENGINE_TEMP: vehicle.engineTemp = value; break;
+        case FIELD_OIL_PRESSURE: vehicle.oilPressure = value; break;
+        case FIELD_BATTERY_VOLTAGE: vehicle.batteryVoltage = value; break;
+        case FIELD_ENGINE_RUNNING: vehicle.engineRunning = on; break;
+        case FIELD_TURN_LEFT: vehicle.turnSignalLeft = on; break;
+        case FIELD_TURN_RIGHT: vehicle.turnSignalRight = on; break;
+        case FIELD_HAZARDS: vehicle.hazardsOn = on; break;
+        case FIELD_LIGHTS: vehicle.lightsOn = on; break;
+        case FIELD_PARKING_BRAKE: vehicle.parkingBrake = on; break;
+        case FIELD_SEATBELT: vehicle.seatbelt = on; break;
+        case FIELD_AC: vehicle.acOn = on; break;
+        default: break;
+    }
+}
+
+void copyVehicleFields(VehicleState& to, const VehicleState& from, uint32_t mask) {
+    auto has = [mask](VehicleField field) { return (mask >> field) & 1u; };
+    if (has(FIELD_SPEED)) to.speed = from.speed;
+    if (has(FIELD_RPM)) to.rpm = from.rpm;
+    if (has(FIELD_FUEL)) to.fuel = from.fuel;
+    if (has(FIELD_ENGINE_TEMP)) to.engineTemp = from.engineTemp;
+    if (has(FIELD_OIL_PRESSURE)) to.oilPressure = from.oilPressure;
+    if (has(FIELD_BATTERY_VOLTAGE)) to.batteryVoltage = from.batteryVoltage;
+    if (has(FIELD_ENGINE_RUNNING)) to.engineRunning = from.engineRunning;
+    if (has(FIELD_TURN_LEFT)) to.turnSignalLeft = from.turnSignalLeft;
+    if (has(FIELD_TURN_RIGHT)) to.turnSignalRight = from.turnSignalRight;
+    if (has(FIELD_HAZARDS)) to.hazardsOn = from.hazardsOn;
+    if (has(FIELD_LIGHTS)) to.lightsOn = from.lightsOn;
+    if (has(FIELD_PARKING_BRAKE)) to.parkingBrake = from.parkingBrake;
+    if (has(FIELD_SEATBELT)) to.seatbelt = from.seatbelt;
+    if (has(FIELD_AC)) to.acOn = from.acOn;
+}
+
+uint64_t evaluateWarnings(const VehicleState& v) {
+    uint64_t mask = 0;
+    auto set = [&mask](int light, bool active) {
+        if (active) mask |= (uint64_t)1 << light;
+    };
+
+    set(WARN_ENGINE, !v.engineRunning && v.speed > 0);
+    set(WARN_OIL_PRESSURE, v.oilPressure < 20);
+    set(WARN_ENGINE_TEMP, v.engineTemp > 110);
+    set(WARN_BATTERY, v.batteryVoltage < 12.0f);
+    set(WARN_FUEL, v.fuel < 10);
+    set(WARN_AC, v.acOn);
+    set(WARN_LIGHTS, v.lightsOn);
+    set(WARN_TURN_LEFT, v.turnSignalLeft || v.hazardsOn);
+    set(WARN_TURN_RIGHT, v.turnSignalRight || v.hazardsOn);
+    set(WARN_PARKING_BRAKE, v.parkingBrake);
+    set(WARN_SEATBELT, !v.seatbelt && v.speed > 0);
+    set(WARN_ABS, false); // Always off in this simulation
+    return mask;
+}
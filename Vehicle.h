@@ -0,0 +1,117 @@
+#ifndef VEHICLE_H
+#define VEHICLE_H
+
+#include <cstdint>
+
+#include "VehicleInput.h"
+
+// Vehicle state
+struct VehicleState {
+    // speed of the vehicle in km/h set to 0.0f initially which 0 km/h 
+    float speed = 0.0f;
+    // RPM of the engine in revolutions per minute set to 800.0f initially which is idle RPM
+    float rpm = 800.0f; // Idle RPM
+    // Fuel level in percentage set to 85.0f initially which is 85% fuel level
+    float fuel = 85.0f;
+    // Engine temperature in degrees Celsius set to 90.0f initially which is normal operating temperature which is 90 degrees Celsius
+    float engineTemp = 90.0f;
+    // oil pressure in PSI set to 45.0f initially which is normal oil pressure
+    float oilPressure = 45.0f;
+    // Battery voltage in volts set to 12.6f initially which is normal battery voltage
+    float batteryVoltage = 12.6f;
+    bool engineRunning = false;
+    bool acOn = false;
+    bool lightsOn = false;
+    bool turnSignalLeft = false;
+    bool turnSignalRight = false;
+    bool hazardsOn = false;
+    bool parkingBrake = true;
+    bool seatbelt = false;
+    // Doors status, false means closed, true means open
+    bool doors[4] = { false, false, false, false }; // FL, FR, RL, RR
+    int gear = 0; // P=0, R=-1, N=0, D=1-8
+    int displayMode = 0; // 0=Normal, 1=Sport, 2=Eco, 3=Comfort
+    // Odometer in kilometers set to 45672.8f initially which is 45672.8 km
+    float odometer = 45672.8f;
+    // Trip A in kilometers set to 0.0f initially which is 0 km
+    float tripA = 0.0f;
+    // Trip B in kilometers set to 158.3f initially which is 158.3 km
+    float tripB = 158.3f;
+    // Average fuel consumption in liters per 100 km set to 7.2f initially which is 7.2 L/100km
+    float avgFuelConsumption = 7.2f;
+    float outsideTemp = 22.5f;
+    int timeHour = 14;
+    int timeMinute = 23;
+    bool throttlePressed = false;
+    float targetSpeed = 0.0f;
+    // Target revolutions per minute (RPM) for the engine, set to 800.0f initially which is idle RPM
+    float targetRPM = 800.0f;
+
+    // Define min and max temps for the gauge
+    float minTemp = -30.0f;
+    float maxTemp = 170.0f;
+};
+
+bool operator==(const VehicleState& a, const VehicleState& b);
+bool operator!=(const VehicleState& a, const VehicleState& b);
+
+// Advance the vehicle simulation by one input step
+void updateVehicle(VehicleState& vehicle, const InputFrame& input);
+
+// State for display between two consecutive steps, t in [0, 1]: gauge and
+// trip values are blended, switches and counters come from the newer step
+VehicleState interpolateVehicle(const VehicleState& from, const VehicleState& to, float t);
+
+// Vehicle values an external data source can drive. Each field is one bit
+// in a source's field mask, so new fields go at the end.
+enum VehicleField {
+    FIELD_SPEED,
+    FIELD_RPM,
+    FIELD_FUEL,
+    FIELD_ENGINE_TEMP,
+    FIELD_OIL_PRESSURE,
+    FIELD_BATTERY_VOLTAGE,
+    FIELD_ENGINE_RUNNING,
+    FIELD_TURN_LEFT,
+    FIELD_TURN_RIGHT,
+    FIELD_HAZARDS,
+    FIELD_LIGHTS,
+    FIELD_PARKING_BRAKE,
+    FIELD_SEATBELT,
+    FIELD_AC,
+    FIELD_COUNT
+};
+
+static_assert(FIELD_COUNT <= 32, "Field masks hold 32 fields");
+
+// Stable names of the fields, e.g. "engineTemp", for mapping external signals
+const char* vehicleFieldName(VehicleField field);
+bool vehicleFieldFromName(const char* name, VehicleField& field);
+
+// Set one field from a physical value; switches are on for any non-zero value
+void setVehicleField(VehicleState& vehicle, VehicleField field, float value);
+
+// Copy the fields in mask from one state to another
+void copyVehicleFields(VehicleState& to, const VehicleState& from, uint32_t mask);
+
+// Tell-tales in panel order; each one's bit in the active mask is its index
+enum WarningLightIndex {
+    WARN_ENGINE,
+    WARN_OIL_PRESSURE,
+    WARN_ENGINE_TEMP,
+    WARN_BATTERY,
+    WARN_FUEL,
+    WARN_AC,
+    WARN_LIGHTS,
+    WARN_TURN_LEFT,
+    WARN_TURN_RIGHT,
+    WARN_PARKING_BRAKE,
+    WARN_SEATBELT,
+    WARN_ABS,
+    WARN_COUNT
+};
+
+// Evaluates every warning condition into the panel's active mask
+uint64_t evaluateWarnings(const VehicleState& v);
+
+#endif
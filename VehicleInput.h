@@ -0,0 +1,41 @@
+#ifndef VEHICLE_INPUT_H
+#define VEHICLE_INPUT_H
+
+#include <cstdint>
+
+// Everything the driver can do, independent of which key does it. Each
+// action is one bit in InputFrame's masks, so new actions go at the end.
+enum InputAction {
+    ACTION_THROTTLE,
+    ACTION_MODE_PREVIOUS,
+    ACTION_MODE_NEXT,
+    ACTION_ENGINE,
+    ACTION_AC,
+    ACTION_LIGHTS,
+    ACTION_TURN_LEFT,
+    ACTION_TURN_RIGHT,
+    ACTION_HAZARDS,
+    ACTION_PARKING_BRAKE,
+    ACTION_SEATBELT,
+    ACTION_RENDER_PATH,
+    ACTION_STATS_DUMP,
+    ACTION_TRACE_DUMP,
+    ACTION_GPU_OVERLAY,
+    ACTION_QUIT,
+    ACTION_COUNT
+};
+
+static_assert(ACTION_COUNT <= 32, "InputFrame masks hold 32 actions");
+
+// Input for one simulation step: which actions are held, which went down
+// since the previous step, and how much time the step covers
+struct InputFrame {
+    float deltaTime;
+    uint32_t held;
+    uint32_t pressed;
+
+    bool isHeld(InputAction action) const { return (held >> action) & 1u; }
+    bool wasPressed(InputAction action) const { return (pressed >> action) & 1u; }
+};
+
+#endif
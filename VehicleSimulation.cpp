@@ -0,0 +1,118 @@
+#include "VehicleSimulation.h"
+#include "IdleWake.h"
+#include "InputRecording.h"
+#include "Profiler.h"
+
+#include <algorithm>
+
+VehicleSimulation::VehicleSimulation(double rateHz)
+    : rateHz(rateHz > 0.0 ? rateHz : DefaultRateHz), recorder(nullptr), idleWake(nullptr),
+      producerTime(0.0), producerSteps(0), steady(true),
+      heldActions(0), pressedActions(0), stopRequested(false)
+{
+    // Nothing has run yet: both steps are the initial state
+    SimulationSnapshot& initial = snapshots.writeBuffer();
+    initial.previous = state;
+    initial.current = state;
+    initial.time = 0.0;
+    initial.stepTime = period();
+    initial.steps = 0;
+    snapshots.publish();
+    snapshots.update();
+}
+
+VehicleSimulation::~VehicleSimulation() {
+    stop();
+}
+
+void VehicleSimulation::start() {
+    if (thread.joinable())
+        return;
+    stopRequested.store(false, std::memory_order_relaxed);
+    startTime = std::chrono::steady_clock::now();
+    thread = std::thread(&VehicleSimulation::run, this);
+}
+
+void VehicleSimulation::stop() {
+    if (!thread.joinable())
+        return;
+    stopRequested.store(true, std::memory_order_relaxed);
+    thread.join();
+}
+
+double VehicleSimulation::clock() const {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+void VehicleSimulation::submitInput(const InputFrame& input) {
+    heldActions.store(input.held, std::memory_order_relaxed);
+    pressedActions.fetch_or(input.pressed, std::memory_order_relaxed);
+}
+
+void VehicleSimulation::step(const InputFrame& input) {
+    advance(input, producerTime + input.deltaTime);
+}
+
+void VehicleSimulation::advance(const InputFrame& input, double time) {
+    PROFILE_ZONE("VehicleSimulation::step");
+    if (recorder)
+        recorder->write(input);
+
+    VehicleState previous = state;
+    updateVehicle(state, input);
+    bool changed = state != previous;
+
+    // Once the newest snapshot shows a steady state, further steady steps
+    // publish nothing, so an idle renderer finds no new data
+    if (changed || !steady) {
+        SimulationSnapshot& snapshot = snapshots.writeBuffer();
+        snapshot.previous = previous;
+        snapshot.current = state;
+        snapshot.time = time;
+        snapshot.stepTime = time - producerTime;
+        snapshot.steps = producerSteps + 1;
+        snapshots.publish();
+    }
+    producerSteps++;
+    steady = !changed;
+
+    if (changed && idleWake)
+        idleWake->notify();
+
+    producerTime = time;
+}
+
+void VehicleSimulation::run() {
+    typedef std::chrono::steady_clock Clock;
+    const Clock::duration stepDuration =
+        std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(period()));
+    const int maxCatchUpSteps = std::max(1, (int)(MaxCatchUpSeconds * rateHz));
+
+    Clock::time_point nextStep = startTime + stepDuration;
+    while (!stopRequested.load(std::memory_order_relaxed)) {
+        std::this_thread::sleep_until(nextStep);
+
+        // Run every step that is due; after a longer stall skip ahead instead
+        // of replaying all of it at once
+        Clock::time_point now = Clock::now();
+        if (now - nextStep > stepDuration * maxCatchUpSteps)
+            nextStep = now;
+
+        while (nextStep <= now) {
+            InputFrame input;
+            input.deltaTime = (float)period();
+            input.held = heldActions.load(std::memory_order_relaxed);
+            input.pressed = pressedActions.exchange(0, std::memory_order_relaxed);
+            advance(input, std::chrono::duration<double>(nextStep - startTime).count());
+            nextStep += stepDuration;
+        }
+    }
+}
+
+VehicleState VehicleSimulation::stateAt(double time) const {
+    const SimulationSnapshot& snapshot = snapshots.read();
+    if (snapshot.stepTime <= 0.0)
+        return snapshot.current;
+    float t = (float)((time - (snapshot.time - snapshot.stepTime)) / snapshot.stepTime);
+    return interpolateVehicle(snapshot.previous, snapshot.current, t);
+}
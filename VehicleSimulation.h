@@ -0,0 +1,97 @@
+#ifndef VEHICLE_SIMULATION_H
+#define VEHICLE_SIMULATION_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#include "TripleBuffer.h"
+#include "Vehicle.h"
+
+class IdleWake; // Forward declarations
+class InputRecorder;
+
+// The two newest simulation steps, handed to the renderer as one unit
+struct SimulationSnapshot {
+    VehicleState previous;
+    VehicleState current;
+    double time;     // Simulation clock at current, in seconds
+    double stepTime; // Seconds between previous and current
+    uint64_t steps;
+};
+
+// Runs updateVehicle at a fixed rate, independent of the frame rate, either on
+// its own thread (live input) or stepped by the caller (replays). Every step is
+// published through a triple buffer; the renderer draws stateAt() a display
+// time, interpolated between the last two steps.
+class VehicleSimulation {
+public:
+    static constexpr double DefaultRateHz = 1000.0;
+    // Longest the thread catches up after a stall before it skips ahead
+    static constexpr double MaxCatchUpSeconds = 0.1;
+
+    explicit VehicleSimulation(double rateHz = DefaultRateHz);
+    ~VehicleSimulation();
+
+    VehicleSimulation(const VehicleSimulation&) = delete;
+    VehicleSimulation& operator=(const VehicleSimulation&) = delete;
+
+    double rate() const { return rateHz; }
+    double period() const { return 1.0 / rateHz; }
+
+    // Every step's input is written here, from whichever thread steps
+    void setRecorder(InputRecorder* inputRecorder) { recorder = inputRecorder; }
+
+    // Notified after every step that changed the state
+    void setIdleWake(IdleWake* wake) { idleWake = wake; }
+
+    // Threaded mode: steps at the fixed rate on the simulation clock, which
+    // counts seconds from start()
+    void start();
+    void stop();
+    bool running() const { return thread.joinable(); }
+    double clock() const;
+
+    // Latest held actions and the ones pressed since the last call; any thread.
+    // Presses accumulate until a step consumes them.
+    void submitInput(const InputFrame& input);
+
+    // Caller-stepped mode: advance by input.deltaTime on the calling thread.
+    // Must not be mixed with start().
+    void step(const InputFrame& input);
+
+    // Producer-side simulation clock after the newest step
+    double simulatedTime() const { return producerTime; }
+
+    // Renderer side: pick up the newest published steps, then interpolate
+    // them at a time on the simulation clock. Steady steps are not published,
+    // so update() stays false while nothing changes.
+    bool update() { return snapshots.update(); }
+    const SimulationSnapshot& latest() const { return snapshots.read(); }
+    VehicleState stateAt(double time) const;
+
+private:
+    void run();
+    void advance(const InputFrame& input, double time);
+
+    double rateHz;
+    InputRecorder* recorder;
+    IdleWake* idleWake;
+
+    // Producer side, touched only by whichever thread steps
+    VehicleState state;
+    double producerTime;
+    uint64_t producerSteps;
+    bool steady; // The newest step left the state unchanged
+
+    TripleBuffer<SimulationSnapshot> snapshots;
+
+    std::atomic<uint32_t> heldActions;
+    std::atomic<uint32_t> pressedActions;
+    std::atomic<bool> stopRequested;
+    std::chrono::steady_clock::time_point startTime;
+    std::thread thread;
+};
+
+#endif
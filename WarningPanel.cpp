@@ -0,0 +1,94 @@
+#include "WarningPanel.h"
+#include "Shader.h"
+#include "Profiler.h"
+#include <algorithm>
+
+namespace {
+    constexpr UniformName activeMaskUniform("activeMask");
+    constexpr UniformName lightSizeUniform("lightSize");
+
+    struct LightInstance {
+        float x, y;
+        float r, g, b;
+        GLuint flags;
+    };
+
+    const GLuint LIGHT_FLAG_BLINK_GATED = 1u;
+}
+
+WarningPanel::WarningPanel(const std::vector<WarningLight>& lights, float x, float y, float size, float spacing)
+    : VAO(0), quadVBO(0), instanceVBO(0),
+      lightCount(std::min((int)lights.size(), MaxLights)), lightSize(size),
+      activeMask(0), uniformsDirty(true)
+{
+    // Unit quad, scaled by lightSize in the shader
+    const float quadVertices[] = {
+        0.0f, 0.0f,
+        1.0f, 0.0f,
+        1.0f, 1.0f,
+        0.0f, 1.0f
+    };
+
+    std::vector<LightInstance> instances;
+    for (int i = 0; i < lightCount; i++) {
+        const WarningLight& light = lights[i];
+        instances.push_back({ x + spacing * i, y, light.r, light.g, light.b,
+                              light.blinkGated ? LIGHT_FLAG_BLINK_GATED : 0u });
+    }
+
+    glGenVertexArrays(1, &VAO);
+    glGenBuffers(1, &quadVBO);
+    glGenBuffers(1, &instanceVBO);
+
+    glBindVertexArray(VAO);
+
+    glBindBuffer(GL_ARRAY_BUFFER, quadVBO);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(quadVertices), quadVertices, GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    glBufferData(GL_ARRAY_BUFFER, instances.size() * sizeof(LightInstance), instances.data(), GL_STATIC_DRAW);
+    // Position
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(LightInstance), (void*)0);
+    glEnableVertexAttribArray(1);
+    glVertexAttribDivisor(1, 1);
+    // Color
+    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(LightInstance), (void*)(2 * sizeof(float)));
+    glEnableVertexAttribArray(2);
+    glVertexAttribDivisor(2, 1);
+    // Flags
+    glVertexAttribIPointer(3, 1, GL_UNSIGNED_INT, sizeof(LightInstance), (void*)(5 * sizeof(float)));
+    glEnableVertexAttribArray(3);
+    glVertexAttribDivisor(3, 1);
+}
+
+WarningPanel::~WarningPanel() {
+    glDeleteVertexArrays(1, &VAO);
+    glDeleteBuffers(1, &quadVBO);
+    glDeleteBuffers(1, &instanceVBO);
+}
+
+void WarningPanel::setActiveMask(uint64_t mask) {
+    if (mask != activeMask) {
+        activeMask = mask;
+        uniformsDirty = true;
+    }
+}
+
+void WarningPanel::draw(const Shader& shader) {
+    PROFILE_ZONE("WarningPanel::draw");
+    if (lightCount == 0)
+        return;
+
+    shader.use();
+    // Program uniforms persist, so they are only sent when something changed
+    if (uniformsDirty) {
+        shader.setUVec2(activeMaskUniform, (GLuint)(activeMask & 0xFFFFFFFFu), (GLuint)(activeMask >> 32));
+        shader.setFloat(lightSizeUniform, lightSize);
+        uniformsDirty = false;
+    }
+
+    glBindVertexArray(VAO);
+    glDrawArraysInstanced(GL_TRIANGLE_FAN, 0, 4, lightCount);
+}
@@ -0,0 +1,43 @@
+#ifndef WARNING_PANEL_H
+#define WARNING_PANEL_H
+
+#include <glad/glad.h>
+#include <cstdint>
+#include <vector>
+
+class Shader; // Forward declaration
+
+// Static description of one tell-tale
+struct WarningLight {
+    float r, g, b;
+    bool blinkGated; // Lit only during the on-phase of the blink (turn signals)
+};
+
+// Draws a row of tell-tales with a single instanced draw. Positions and
+// colors live in a static per-instance buffer; the only per-frame input is
+// the active mask, and blinking is evaluated in the shader from FrameBlock time.
+class WarningPanel {
+public:
+    static const int MaxLights = 64;
+
+    WarningPanel(const std::vector<WarningLight>& lights, float x, float y, float size, float spacing);
+    ~WarningPanel();
+
+    // Bit i lights tell-tale i; only re-uploaded when it changes
+    void setActiveMask(uint64_t mask);
+
+    void draw(const Shader& shader);
+
+    int count() const { return lightCount; }
+
+private:
+    // OpenGL objects
+    GLuint VAO, quadVBO, instanceVBO;
+
+    int lightCount;
+    float lightSize;
+    uint64_t activeMask;
+    bool uniformsDirty;
+};
+
+#endif
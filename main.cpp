@@ -4,385 +4,250 @@
 #include <string>
 #include <sstream>
 #include <iomanip>
-
-#include "Shader.h"
-#include "Gauge.h"
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <chrono>
+#include <thread>
+
+#include "AllocationCounter.h"
+#include "ClusterRenderer.h"
+#include "FrameStats.h"
+#include "Profiler.h"
+#include "PerfCounters.h"
+#include "RenderTarget.h"
+#include "SharedVehicleState.h"
+#include "SignalBus.h"
+#include "UdpReceiver.h"
+#include "Vehicle.h"
+#include "VehicleSimulation.h"
+#include "CanReceiver.h"
+#include "CandumpReplay.h"
+#include "IdleWake.h"
+#include "InputRecording.h"
+#include "KeyboardInput.h"
 
 // Window dimensions and called also aspect ratio
 const unsigned int WIDTH = 1360;
 const unsigned int HEIGHT = 768;
 
-// Vehicle state
-struct VehicleState {
-    // speed of the vehicle in km/h set to 0.0f initially which 0 km/h 
-    float speed = 0.0f;
-    // RPM of the engine in revolutions per minute set to 800.0f initially which is idle RPM
-    float rpm = 800.0f; // Idle RPM
-    // Fuel level in percentage set to 85.0f initially which is 85% fuel level
-    float fuel = 85.0f;
-    // Engine temperature in degrees Celsius set to 90.0f initially which is normal operating temperature which is 90 degrees Celsius
-    float engineTemp = 90.0f;
-    // oil pressure in PSI set to 45.0f initially which is normal oil pressure
-    float oilPressure = 45.0f;
-    // Battery voltage in volts set to 12.6f initially which is normal battery voltage
-    float batteryVoltage = 12.6f;
-    bool engineRunning = false;
-    bool acOn = false;
-    bool lightsOn = false;
-    bool turnSignalLeft = false;
-    bool turnSignalRight = false;
-    bool hazardsOn = false;
-    bool parkingBrake = true;
-    bool seatbelt = false;
-    // Doors status, false means closed, true means open
-    bool doors[4] = { false, false, false, false }; // FL, FR, RL, RR
-    int gear = 0; // P=0, R=-1, N=0, D=1-8
-    int displayMode = 0; // 0=Normal, 1=Sport, 2=Eco, 3=Comfort
-    // Odometer in kilometers set to 45672.8f initially which is 45672.8 km
-    float odometer = 45672.8f;
-    // Trip A in kilometers set to 0.0f initially which is 0 km
-    float tripA = 0.0f;
-    // Trip B in kilometers set to 158.3f initially which is 158.3 km
-    float tripB = 158.3f;
-    // Average fuel consumption in liters per 100 km set to 7.2f initially which is 7.2 L/100km
-    float avgFuelConsumption = 7.2f;
-    float outsideTemp = 22.5f;
-    int timeHour = 14;
-    int timeMinute = 23;
-    bool throttlePressed = false;
-    float targetSpeed = 0.0f;
-    // Target revolutions per minute (RPM) for the engine, set to 800.0f initially which is idle RPM
-    float targetRPM = 800.0f;
-
-    // Define min and max temps for the gauge
-    float minTemp = -30.0f;
-    float maxTemp = 170.0f;
-};
-
-VehicleState vehicle;
-// Last time the frame was updated
-double lastTime = 0.0;
-// Blink timer for turn signals and hazards
-float blinkTimer = 0.0f;
-
-// Enhanced vertex shader with better lighting support
-const char* vertexShaderSrc = R"(
-#version 330 core
-layout(location = 0) in vec2 aPos;
-
-uniform float rotation;
-uniform vec2 offset;
-uniform vec2 scale;
-
-void main()
-{
-    float cosR = cos(rotation);
-    float sinR = sin(rotation);
-    vec2 rotatedPos = vec2(
-        aPos.x * cosR - aPos.y * sinR,
-        aPos.x * sinR + aPos.y * cosR
-    );
-
-    vec2 scaledPos = rotatedPos * scale;
-    vec2 finalPos = scaledPos + offset;
-
-    float x = finalPos.x / 500.0;
-    float y = finalPos.y / 300.0;
-
-    gl_Position = vec4(x, y, 0.0, 1.0);
-}
-)";
 
-// Enhanced fragment shader with better color support
-const char* fragmentShaderSrc = R"(
-#version 330 core
-out vec4 FragColor;
-
-uniform vec3 color;
-uniform float alpha;
+// How the gauges are drawn; G cycles through the paths at runtime
+GaugeRenderPath gaugeRenderPath = GaugeRenderPath::CACHED_FACE;
+
+// Set when the screen must be redrawn even though the vehicle state did not change
+bool redrawRequested = true;
+
+// Frame statistics are written here on exit and when F is pressed
+const char* FRAME_STATS_PATH = "frame_stats.json";
+bool statsDumpRequested = false;
+
+// CPU profiler zones are exported here on exit and when T is pressed
+const char* TRACE_PATH = "cluster_trace.json";
+bool traceDumpRequested = false;
+
+// On-screen bars with the GPU cost of each render pass, toggled with O
+bool gpuOverlayVisible = false;
+
+// How long an idle loop blocks waiting for input when nothing is animating
+const double IDLE_WAIT_TIMEOUT = 0.5;
+
+// Key for each action, dispatched from the key callback
+const KeyBinding keyBindings[] = {
+    { GLFW_KEY_SPACE, ACTION_THROTTLE },
+    { GLFW_KEY_Q, ACTION_MODE_PREVIOUS },
+    { GLFW_KEY_E, ACTION_MODE_NEXT },
+    { GLFW_KEY_I, ACTION_ENGINE },
+    { GLFW_KEY_A, ACTION_AC },
+    { GLFW_KEY_L, ACTION_LIGHTS },
+    { GLFW_KEY_LEFT, ACTION_TURN_LEFT },
+    { GLFW_KEY_RIGHT, ACTION_TURN_RIGHT },
+    { GLFW_KEY_H, ACTION_HAZARDS },
+    { GLFW_KEY_P, ACTION_PARKING_BRAKE },
+    { GLFW_KEY_B, ACTION_SEATBELT },
+    { GLFW_KEY_G, ACTION_RENDER_PATH },
+    { GLFW_KEY_F, ACTION_STATS_DUMP },
+    { GLFW_KEY_T, ACTION_TRACE_DUMP },
+    { GLFW_KEY_O, ACTION_GPU_OVERLAY },
+    { GLFW_KEY_ESCAPE, ACTION_QUIT }
+};
 
-void main()
-{
-    FragColor = vec4(color, alpha);
-}
-)";
+// Cluster controls that do not touch the vehicle; the vehicle itself is
+// stepped by the simulation
+void processInput(GLFWwindow* window, const InputFrame& input) {
+    PROFILE_ZONE("processInput");
 
-void processInput(GLFWwindow* window, float deltaTime) {
     // Check if the ESC key was pressed to close the window
-    if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
+    if (input.isHeld(ACTION_QUIT))
         glfwSetWindowShouldClose(window, true);
 
-    // Throttle control
-    bool currentThrottle = glfwGetKey(window, GLFW_KEY_SPACE) == GLFW_PRESS;
-    vehicle.throttlePressed = currentThrottle;
-
-    // Update vehicle speed and RPM based on throttle input
-    if (currentThrottle && vehicle.engineRunning) {
-        // Increase the speed by 50 * deltaTime, but don't go past 250 (speed cap).
-        vehicle.targetSpeed = std::min(vehicle.targetSpeed + 50.0f * deltaTime, 250.0f);
-        // Increase the RPM by 2000 * deltaTime, but don't go past 7000 (RPM cap).
-        vehicle.targetRPM = std::min(vehicle.targetRPM + 2000.0f * deltaTime, 7000.0f);
+    // Gauge render path
+    if (input.wasPressed(ACTION_RENDER_PATH)) {
+        static const char* pathNames[] = { "mesh", "cached face", "sdf" };
+        gaugeRenderPath = (GaugeRenderPath)(((int)gaugeRenderPath + 1) % 3);
+        redrawRequested = true;
+        std::cout << "Gauge render path: " << pathNames[(int)gaugeRenderPath] << "\n";
     }
-    else {
-        // If throttle is not pressed, decrease speed and RPM
-        vehicle.targetSpeed = std::max(vehicle.targetSpeed - 30.0f * deltaTime, 0.0f);
-        if (vehicle.engineRunning) {
-            vehicle.targetRPM = std::max(vehicle.targetRPM - 1500.0f * deltaTime, 800.0f);
-        }
-        else {
-            vehicle.targetRPM = 0.0f;
-        }
-    }
-
-    // Smooth transitions
-    vehicle.speed += (vehicle.targetSpeed - vehicle.speed) * 5.0f * deltaTime;
-    vehicle.rpm += (vehicle.targetRPM - vehicle.rpm) * 3.0f * deltaTime;
-
-    // Mode switching
-    static bool qPressed = false, ePressed = false;
-    bool qCurrent = glfwGetKey(window, GLFW_KEY_Q) == GLFW_PRESS;
-    bool eCurrent = glfwGetKey(window, GLFW_KEY_E) == GLFW_PRESS;
 
-    if (qCurrent && !qPressed) {
-        vehicle.displayMode = (vehicle.displayMode - 1 + 4) % 4;
-    }
-    if (eCurrent && !ePressed) {
-        vehicle.displayMode = (vehicle.displayMode + 1) % 4;
-    }
-    qPressed = qCurrent;
-    ePressed = eCurrent;
-
-    // Vehicle controls
-    static bool keyStates[256] = { false };
-
-    // Engine start/stop
-    if (glfwGetKey(window, GLFW_KEY_I) == GLFW_PRESS && !keyStates[GLFW_KEY_I]) {
-        vehicle.engineRunning = !vehicle.engineRunning;
-        if (!vehicle.engineRunning) {
-            vehicle.targetRPM = 0.0f;
-            vehicle.targetSpeed = 0.0f;
-        }
-        else {
-            vehicle.targetRPM = 800.0f;
-        }
-    }
-
-    // AC toggle
-    if (glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS && !keyStates[GLFW_KEY_A]) {
-        vehicle.acOn = !vehicle.acOn;
+    // Frame statistics dump
+    if (input.wasPressed(ACTION_STATS_DUMP)) {
+        statsDumpRequested = true;
     }
 
-    // Lights toggle
-    if (glfwGetKey(window, GLFW_KEY_L) == GLFW_PRESS && !keyStates[GLFW_KEY_L]) {
-        vehicle.lightsOn = !vehicle.lightsOn;
-    }
-
-    // Turn signals
-    if (glfwGetKey(window, GLFW_KEY_LEFT) == GLFW_PRESS && !keyStates[GLFW_KEY_LEFT]) {
-        vehicle.turnSignalLeft = !vehicle.turnSignalLeft;
-        if (vehicle.turnSignalLeft) vehicle.turnSignalRight = false;
-    }
-    if (glfwGetKey(window, GLFW_KEY_RIGHT) == GLFW_PRESS && !keyStates[GLFW_KEY_RIGHT]) {
-        vehicle.turnSignalRight = !vehicle.turnSignalRight;
-        if (vehicle.turnSignalRight) vehicle.turnSignalLeft = false;
-    }
-
-    // Hazards
-    if (glfwGetKey(window, GLFW_KEY_H) == GLFW_PRESS && !keyStates[GLFW_KEY_H]) {
-        vehicle.hazardsOn = !vehicle.hazardsOn;
-        if (vehicle.hazardsOn) {
-            vehicle.turnSignalLeft = false;
-            vehicle.turnSignalRight = false;
-        }
+    // CPU trace export
+    if (input.wasPressed(ACTION_TRACE_DUMP)) {
+        traceDumpRequested = true;
     }
 
-    // Parking brake
-    if (glfwGetKey(window, GLFW_KEY_P) == GLFW_PRESS && !keyStates[GLFW_KEY_P]) {
-        vehicle.parkingBrake = !vehicle.parkingBrake;
+    // GPU pass overlay
+    if (input.wasPressed(ACTION_GPU_OVERLAY)) {
+        gpuOverlayVisible = !gpuOverlayVisible;
+        redrawRequested = true;
     }
+}
 
-    // Seatbelt
-    if (glfwGetKey(window, GLFW_KEY_B) == GLFW_PRESS && !keyStates[GLFW_KEY_B]) {
-        vehicle.seatbelt = !vehicle.seatbelt;
-    }
-
-    // Update key states
-    for (int i = 0; i < 256; i++) {
-        keyStates[i] = glfwGetKey(window, i) == GLFW_PRESS;
-    }
-
-    // Update timers and dynamic values
-    blinkTimer += deltaTime;
-    if (blinkTimer >= 1.0f) blinkTimer = 0.0f;
-
-    // Simulate fuel consumption
-    if (vehicle.engineRunning && vehicle.speed > 0) {
-        vehicle.fuel -= 0.5f * deltaTime * (vehicle.speed / 100.0f);
-        vehicle.fuel = std::max(vehicle.fuel, 0.0f);
-
-        vehicle.tripA += vehicle.speed * deltaTime / 3600.0f; // km/h to km
-    }
+// Tell-tales blink at 1 Hz: on for the first half of every second
+bool blinkPhaseOn(double time) {
+    return time - std::floor(time) < 0.5;
+}
 
-    // Engine temperature simulation
-    if (vehicle.engineRunning) {
-        float targetTemp = 90.0f + (vehicle.rpm - 800.0f) / 100.0f;
-        vehicle.engineTemp += (targetTemp - vehicle.engineTemp) * 0.5f * deltaTime;
-    }
-    else {
-        vehicle.engineTemp += (20.0f - vehicle.engineTemp) * 0.1f * deltaTime;
-    }
+double timeToNextBlinkEdge(double time) {
+    return (std::floor(time * 2.0) + 1.0) / 2.0 - time;
 }
 
-void drawRectangle(const Shader& shader, float x, float y, float width, float height, float r, float g, float b, float a = 1.0f) {
-    float vertices[] = {
-        x, y,
-        x + width, y,
-        x + width, y + height,
-        x, y + height
-    };
-
-    GLuint VAO, VBO;
-    glGenVertexArrays(1, &VAO);
-    glGenBuffers(1, &VBO);
-
-    glBindVertexArray(VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
-
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-
-    shader.use();
-    shader.setFloat("rotation", 0.0f);
-    shader.setVec2("offset", 0.0f, 0.0f);
-    shader.setVec2("scale", 1.0f, 1.0f);
-    shader.setVec3("color", r, g, b);
-    shader.setFloat("alpha", a);
-
-    glBindVertexArray(VAO);
-    glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-
-    glDeleteVertexArrays(1, &VAO);
-    glDeleteBuffers(1, &VBO);
+void windowRefreshCallback(GLFWwindow*) {
+    redrawRequested = true;
 }
 
-// Draws a warning light with blinking effect
-void drawWarningLight(const Shader& shader, float x, float y, float size, bool active, float r, float g, float b) {
-    if (active) {
-        float alpha = (blinkTimer < 0.5f) ? 1.0f : 0.3f;
-        drawRectangle(shader, x, y, size, size, r, g, b, alpha);
-    }
-    else {
-        drawRectangle(shader, x, y, size, size, 0.2f, 0.2f, 0.2f, 0.3f);
-    }
+const uint64_t HEADLESS_DEFAULT_FRAMES = 600;
+
+void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " [options]\n";
+    std::cout << "  --perf-counters   Report CPU hardware counters per frame phase on exit (Linux)\n";
+    std::cout << "  --headless        Render offscreen without a visible window and print throughput\n";
+    std::cout << "  --frames N        Frames to render in headless mode (default " << HEADLESS_DEFAULT_FRAMES << ", or the whole replay)\n";
+    std::cout << "  --record FILE     Record every input step to FILE\n";
+    std::cout << "  --replay FILE     Drive the simulation from a recording instead of the keyboard\n";
+    std::cout << "  --replay-speed X  Replay at X times real time; 0 runs as fast as possible (default 1)\n";
+    std::cout << "  --can IFACE       Drive the decoded values from a SocketCAN interface, e.g. vcan0 (Linux)\n";
+    std::cout << "  --dbc FILE        Decode CAN frames with the signals of a DBC file\n";
+    std::cout << "  --candump FILE    Replay a candump log (candump -l) through the CAN decoder\n";
+    std::cout << "  --candump-speed X Replay the log at X times its timing; 0 runs as fast as possible (default 1)\n";
+    std::cout << "  --candump-start S Fast-forward through the first S seconds of the log\n";
+    std::cout << "  --udp [ADDR:]PORT Take telemetry packets from a UDP port (Linux)\n";
+    std::cout << "  --shm [NAME]      Take values published to POSIX shared memory (default " << SHARED_VEHICLE_DEFAULT_NAME << ")\n";
+    std::cout << "  --sim-rate HZ     Vehicle simulation steps per second (default " << VehicleSimulation::DefaultRateHz << ")\n";
+    std::cout << "  --help            Show this message\n";
 }
 
-// Draws the digital display with mode indicator, gear, time, and temperature
-void drawDigitalDisplay(const Shader& shader) {
-    // Main display background with modern dark styling
-    drawRectangle(shader, -200, 150, 400, 100, 0.05f, 0.05f, 0.1f);
-
-    // Mode indicator with improved styling
-    const char* modes[] = { "COMFORT", "SPORT", "ECO", "INDIVIDUAL" };
-    float modeColors[][3] = { 
-        {0.0f, 0.6f, 1.0f},   // Comfort - Blue
-        {1.0f, 0.2f, 0.0f},   // Sport - Red
-        {0.0f, 1.0f, 0.2f},   // Eco - Green
-        {0.8f, 0.0f, 1.0f}    // Individual - Purple
-    };
-
-    // Mode background
-    drawRectangle(shader, -180, 180, 80, 30, 0.1f, 0.1f, 0.15f);
-    // Mode color indicator
-    drawRectangle(shader, -175, 185, 70, 20, 
-                  modeColors[vehicle.displayMode][0],
-                  modeColors[vehicle.displayMode][1],
-                  modeColors[vehicle.displayMode][2]);
-
-    // Gear indicator with enhanced styling
-    drawRectangle(shader, -50, 180, 60, 40, 0.1f, 0.1f, 0.15f);
-    if (vehicle.gear == 0) {
-        drawRectangle(shader, -40, 190, 40, 20, 0.0f, 1.0f, 0.0f); // P - Green
-    }
-    else if (vehicle.gear == -1) {
-        drawRectangle(shader, -40, 190, 40, 20, 1.0f, 0.5f, 0.0f); // R - Orange
-    }
-    else if (vehicle.gear > 0) {
-        drawRectangle(shader, -40, 190, 40, 20, 0.0f, 0.8f, 1.0f); // D - Blue
+int main(int argc, char** argv) {
+    bool usePerfCounters = false;
+    bool headless = false;
+    uint64_t headlessFrames = 0;
+    const char* recordPath = nullptr;
+    const char* replayPath = nullptr;
+    double replaySpeed = 1.0;
+    double simulationRate = VehicleSimulation::DefaultRateHz;
+    const char* canInterface = nullptr;
+    const char* dbcPath = nullptr;
+    const char* candumpPath = nullptr;
+    double candumpSpeed = 1.0;
+    double candumpStart = 0.0;
+    const char* sharedStateName = nullptr;
+    const char* udpEndpoint = nullptr;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--perf-counters") {
+            usePerfCounters = true;
+        }
+        else if (arg == "--headless") {
+            headless = true;
+        }
+        else if (arg == "--frames" && i + 1 < argc) {
+            long long frames = std::atoll(argv[++i]);
+            if (frames <= 0) {
+                std::cerr << "ERROR::ARGS::INVALID_FRAME_COUNT: " << argv[i] << "\n";
+                return -1;
+            }
+            headlessFrames = (uint64_t)frames;
+        }
+        else if (arg == "--record" && i + 1 < argc) {
+            recordPath = argv[++i];
+        }
+        else if (arg == "--replay" && i + 1 < argc) {
+            replayPath = argv[++i];
+        }
+        else if (arg == "--replay-speed" && i + 1 < argc) {
+            replaySpeed = std::atof(argv[++i]);
+            if (replaySpeed < 0.0) {
+                std::cerr << "ERROR::ARGS::INVALID_REPLAY_SPEED: " << argv[i] << "\n";
+                return -1;
+            }
+        }
+        else if (arg == "--can" && i + 1 < argc) {
+            canInterface = argv[++i];
+        }
+        else if (arg == "--dbc" && i + 1 < argc) {
+            dbcPath = argv[++i];
+        }
+        else if (arg == "--candump" && i + 1 < argc) {
+            candumpPath = argv[++i];
+        }
+        else if (arg == "--candump-speed" && i + 1 < argc) {
+            candumpSpeed = std::atof(argv[++i]);
+            if (candumpSpeed < 0.0) {
+                std::cerr << "ERROR::ARGS::INVALID_CANDUMP_SPEED: " << argv[i] << "\n";
+                return -1;
+            }
+        }
+        else if (arg == "--candump-start" && i + 1 < argc) {
+            candumpStart = std::atof(argv[++i]);
+        }
+        else if (arg == "--udp" && i + 1 < argc) {
+            udpEndpoint = argv[++i];
+        }
+        else if (arg == "--shm") {
+            sharedStateName = i + 1 < argc && argv[i + 1][0] == '/' ? argv[++i] : SHARED_VEHICLE_DEFAULT_NAME;
+        }
+        else if (arg == "--sim-rate" && i + 1 < argc) {
+            simulationRate = std::atof(argv[++i]);
+            if (simulationRate <= 0.0) {
+                std::cerr << "ERROR::ARGS::INVALID_SIMULATION_RATE: " << argv[i] << "\n";
+                return -1;
+            }
+        }
+        else if (arg == "--help") {
+            printUsage(argv[0]);
+            return 0;
+        }
+        else {
+            std::cerr << "ERROR::ARGS::UNKNOWN_OPTION: " << arg << "\n";
+            printUsage(argv[0]);
+            return -1;
+        }
     }
 
-    // Time display with blue accent
-    drawRectangle(shader, 80, 180, 100, 30, 0.1f, 0.1f, 0.15f);
-    drawRectangle(shader, 85, 185, 90, 20, 0.0f, 0.4f, 0.8f);
-
-    // Temperature and other info with conditional coloring
-    drawRectangle(shader, -150, 120, 60, 20, 
-                  vehicle.outsideTemp < 5 ? 0.0f : 0.6f,
-                  vehicle.outsideTemp < 5 ? 0.6f : 0.8f,
-                  vehicle.outsideTemp < 5 ? 1.0f : 0.0f);
-
-    // Speed display (digital)
-    drawRectangle(shader, -50, 50, 100, 50, 0.0f, 0.0f, 0.0f, 0.8f);
-    
-    // Central info display
-    drawRectangle(shader, -100, -20, 200, 60, 0.02f, 0.02f, 0.05f);
-}
+    InputRecorder recorder;
+    if (recordPath && !recorder.open(recordPath))
+        return -1;
 
-void drawWarningPanel(const Shader& shader) {
-    float y = -250;
-    float size = 25;
-    float spacing = 70;
-    float x = -400;
-
-    // Engine warning
-    drawWarningLight(shader, x, y, size, !vehicle.engineRunning && vehicle.speed > 0, 1.0f, 0.0f, 0.0f);
-    x += spacing;
-
-    // Oil pressure
-    drawWarningLight(shader, x, y, size, vehicle.oilPressure < 20, 1.0f, 0.5f, 0.0f);
-    x += spacing;
-
-    // Engine temperature
-    drawWarningLight(shader, x, y, size, vehicle.engineTemp > 110, 1.0f, 0.0f, 0.0f);
-    x += spacing;
-
-    // Battery
-    drawWarningLight(shader, x, y, size, vehicle.batteryVoltage < 12.0f, 1.0f, 1.0f, 0.0f);
-    x += spacing;
-
-    // Fuel
-    drawWarningLight(shader, x, y, size, vehicle.fuel < 10, 1.0f, 0.5f, 0.0f);
-    x += spacing;
-
-    // AC indicator
-    drawWarningLight(shader, x, y, size, vehicle.acOn, 0.0f, 0.8f, 1.0f);
-    x += spacing;
-
-    // Lights
-    drawWarningLight(shader, x, y, size, vehicle.lightsOn, 0.0f, 1.0f, 0.0f);
-    x += spacing;
-
-    // Turn signals
-    bool leftBlink = vehicle.turnSignalLeft || vehicle.hazardsOn;
-    bool rightBlink = vehicle.turnSignalRight || vehicle.hazardsOn;
-    drawWarningLight(shader, x, y, size, leftBlink && blinkTimer < 0.5f, 0.0f, 1.0f, 0.0f);
-    x += spacing;
-    drawWarningLight(shader, x, y, size, rightBlink && blinkTimer < 0.5f, 0.0f, 1.0f, 0.0f);
-    x += spacing;
-
-    // Parking brake
-    drawWarningLight(shader, x, y, size, vehicle.parkingBrake, 1.0f, 0.0f, 0.0f);
-    x += spacing;
-
-    // Seatbelt
-    drawWarningLight(shader, x, y, size, !vehicle.seatbelt && vehicle.speed > 0, 1.0f, 0.0f, 0.0f);
-    x += spacing;
-
-    // ABS (always off in this simulation)
-    drawWarningLight(shader, x, y, size, false, 1.0f, 1.0f, 0.0f);
-}
+    InputReplay replay;
+    if (replayPath && !replay.open(replayPath))
+        return -1;
+
+    // A headless replay runs to the end of the recording unless told otherwise
+    if (headlessFrames == 0)
+        headlessFrames = replay.isOpen() ? UINT64_MAX : HEADLESS_DEFAULT_FRAMES;
+
+    // Headless runs prefer GLFW's null platform, which needs no display server
+    // and gets a surfaceless EGL context (Mesa llvmpipe on GPU-less machines).
+    // Without it they fall back to a hidden window; either way frames go to an FBO.
+    bool nullPlatform = headless && glfwPlatformSupported(GLFW_PLATFORM_NULL);
+    if (nullPlatform)
+        glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
 
-int main() {
     if (!glfwInit()) {
         std::cerr << "GLFW init failed\n";
         return -1;
@@ -390,6 +255,10 @@ int main() {
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    if (headless)
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    if (nullPlatform)
+        glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_EGL_CONTEXT_API);
 
     GLFWwindow* window = glfwCreateWindow(WIDTH, HEIGHT, "Mercedes-Benz Instrument Cluster", NULL, NULL);
     if (!window) {
@@ -398,25 +267,37 @@ int main() {
         return -1;
     }
     glfwMakeContextCurrent(window);
+    glfwSetWindowRefreshCallback(window, windowRefreshCallback);
+
+    KeyboardInput keyboard(keyBindings, sizeof(keyBindings) / sizeof(keyBindings[0]));
+    keyboard.attach(window);
 
     if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress)) {
         std::cerr << "Failed to init GLAD\n";
         return -1;
     }
 
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    // Headless frames are rendered here instead of the window's back buffer
+    RenderTarget offscreen;
+    if (headless) {
+        glfwSwapInterval(0);
+        offscreen.resize(WIDTH, HEIGHT);
+        std::cout << "Headless rendering at " << WIDTH << "x" << HEIGHT
+                  << " on " << glGetString(GL_RENDERER) << "\n";
+    }
+
+    ClusterRenderer renderer;
 
-    Shader shader(vertexShaderSrc, fragmentShaderSrc);
+    const GLFWvidmode* videoMode = glfwGetVideoMode(glfwGetPrimaryMonitor());
+    double refreshRate = videoMode && videoMode->refreshRate > 0 ? videoMode->refreshRate : 60.0;
+    FrameStats frameStats(refreshRate);
 
-    // Create gauges with enhanced styling
-    Gauge speedometer(-250.0f, -50.0f, 120.0f, GaugeType::FULL_CIRCLE);
-    Gauge tachometer(250.0f, -50.0f, 120.0f, GaugeType::FULL_CIRCLE);
-    Gauge fuelGauge(400.0f, -20.0f, 60.0f, GaugeType::QUADRANT_1);
-    Gauge tempGauge(400.0f, -80.0f, 60.0f, GaugeType::QUADRANT_4);
+    renderer.setRefreshPeriod((float)(1000.0 / refreshRate));
+    frameStats.setPassTimer(&renderer.gpuTimer());
 
-    glLineWidth(3.0f);
-    lastTime = glfwGetTime();
+    PerfCounters perfCounters;
+    if (usePerfCounters)
+        perfCounters.open();
 
     std::cout << "Enhanced Mercedes-Benz Instrument Cluster Controls:\n";
     std::cout << "SPACE - Throttle\n";
@@ -428,51 +309,284 @@ int main() {
     std::cout << "H - Hazard lights\n";
     std::cout << "P - Parking brake\n";
     std::cout << "B - Seatbelt\n";
+    std::cout << "G - Switch gauge render path\n";
+    std::cout << "F - Write frame statistics to " << FRAME_STATS_PATH << "\n";
+    std::cout << "T - Write CPU trace to " << TRACE_PATH << "\n";
+    std::cout << "O - GPU pass overlay (top to bottom:";
+    for (int i = 0; i < renderer.gpuTimer().passCount(); i++)
+        std::cout << (i > 0 ? ", " : " ") << renderer.gpuTimer().passName(i);
+    std::cout << ")\n";
     std::cout << "ESC - Exit\n\n";
 
-    while (!glfwWindowShouldClose(window)) {
+    // Heap allocations made between input and the final flush of each frame.
+    // The first frame is warm-up: drivers compile and allocate lazily on first draw.
+    uint64_t frameCount = 0;
+    uint64_t hotPathAllocations = 0;
+    uint64_t framesWithAllocations = 0;
+
+    // Every displayed value goes through the bus; the renderer reads it from
+    // there, and a frame is only drawn when a channel changed since the last
+    SignalBus signalBus;
+    uint64_t renderedVersion = 0;
+    bool renderedBlinkOn = false;
+    uint64_t skippedFrames = 0;
+
+    // Live input is simulated on its own thread at a fixed rate. Replays step
+    // the simulation on this thread instead: each frame advances the replay
+    // clock by one refresh period and runs the recorded steps up to it, so
+    // every run sees the same states no matter how fast frames are produced.
+    IdleWake idleWake(glfwPostEmptyEvent);
+    VehicleSimulation simulation(simulationRate);
+    simulation.setRecorder(&recorder);
+    simulation.setIdleWake(&idleWake);
+    double replayTime = 0.0;
+    double replayFramePeriod = 1.0 / refreshRate;
+    if (replay.isOpen())
+        std::cout << "Replaying " << replay.size() << " input steps from " << replayPath << "\n";
+    else
+        simulation.start();
+
+    // Values the bus sends replace the simulated ones; the rest stay simulated
+    CanDecoder canDecoder;
+    if (dbcPath) {
+        if (!canDecoder.loadDbc(dbcPath))
+            return -1;
+        std::cout << "Loaded " << canDecoder.signalCount() << " cluster signals in "
+                  << canDecoder.messageCount() << " messages from " << dbcPath << "\n";
+    }
+    CanReceiver canReceiver(canDecoder);
+    if (canInterface) {
+        if (!canReceiver.open(canInterface))
+            return -1;
+        canReceiver.start(&idleWake);
+        std::cout << "Reading CAN frames from " << canInterface << "\n";
+    }
+    CandumpReplay candump(canDecoder);
+    if (candumpPath) {
+        if (!candump.open(candumpPath))
+            return -1;
+        candump.start(candumpSpeed, candumpStart, &idleWake);
+        std::cout << "Replaying CAN log " << candumpPath << "\n";
+    }
+    UdpReceiver udpReceiver;
+    if (udpEndpoint) {
+        if (!udpReceiver.open(udpEndpoint))
+            return -1;
+        udpReceiver.start(&idleWake);
+        std::cout << "Reading telemetry packets on UDP " << udpEndpoint << "\n";
+    }
+    SharedVehicleReader sharedState;
+    if (sharedStateName) {
+        if (!sharedState.open(sharedStateName))
+            return -1;
+        std::cout << "Reading vehicle values from shared memory " << sharedStateName << "\n";
+    }
+
+    double runStartTime = glfwGetTime();
+
+    while (!glfwWindowShouldClose(window) && !(headless && frameCount >= headlessFrames)) {
         double currentTime = glfwGetTime();
-        float deltaTime = float(currentTime - lastTime);
-        lastTime = currentTime;
-
-        processInput(window, deltaTime);
-
-        // Enhanced background colors based on mode
-        float bgColors[][3] = { 
-            {0.01f, 0.01f, 0.03f},   // Comfort - Dark blue
-            {0.03f, 0.01f, 0.01f},   // Sport - Dark red
-            {0.01f, 0.03f, 0.01f},   // Eco - Dark green
-            {0.03f, 0.01f, 0.03f}    // Individual - Dark purple
-        };
-        glClearColor(bgColors[vehicle.displayMode][0], 
-                     bgColors[vehicle.displayMode][1], 
-                     bgColors[vehicle.displayMode][2], 1.0f);
-        glClear(GL_COLOR_BUFFER_BIT);
-
-        // Calculate gauge angles using the new system
-        float speedAngle = speedometer.getAngleForValue(vehicle.speed / 250.0f);
-        float rpmAngle = tachometer.getAngleForValue(vehicle.rpm / 8000.0f);
-        float fuelAngle = fuelGauge.getAngleForValue(vehicle.fuel / 100.0f);
-        
-        // Temperature mapping: clamp and normalize
-        float clampedTemp = std::max(vehicle.minTemp, std::min(vehicle.engineTemp, vehicle.maxTemp));
-        float tempNormalized = (clampedTemp - vehicle.minTemp) / (vehicle.maxTemp - vehicle.minTemp);
-        float tempAngle = tempGauge.getAngleForValue(tempNormalized);
-
-        // Draw main gauges with enhanced styling
-        speedometer.draw(shader, speedAngle, true);
-        tachometer.draw(shader, rpmAngle, true);
-        fuelGauge.draw(shader, fuelAngle, false);
-        tempGauge.draw(shader, tempAngle, false);
-
-        // Draw digital displays and warning lights
-        drawDigitalDisplay(shader);
-        drawWarningPanel(shader);
-
-        glfwSwapBuffers(window);
+
+        uint64_t allocationsAtFrameStart = AllocationCounter::count();
+
+        perfCounters.begin(PERF_PHASE_INPUT);
+        double displayTime;
+        if (replay.isOpen()) {
+            replayTime += replayFramePeriod;
+            currentTime = replayTime;
+
+            bool replayFinished = false;
+            while (simulation.simulatedTime() < replayTime) {
+                InputFrame input;
+                if (!replay.next(input)) {
+                    replayFinished = true;
+                    break;
+                }
+                processInput(window, input);
+                simulation.step(input);
+            }
+            if (replayFinished) {
+                perfCounters.end(PERF_PHASE_INPUT);
+                break;
+            }
+            displayTime = replayTime;
+
+            // Hold back until real time catches up with the scaled replay clock
+            if (replaySpeed > 0.0) {
+                double wait = replayTime / replaySpeed - (glfwGetTime() - runStartTime);
+                if (wait > 0.0)
+                    std::this_thread::sleep_for(std::chrono::duration<double>(wait));
+            }
+        }
+        else {
+            InputFrame input = keyboard.sample();
+            processInput(window, input);
+            simulation.submitInput(input);
+
+            // One step behind the simulation clock, so the newest two steps
+            // usually bracket it
+            displayTime = simulation.clock() - simulation.period();
+        }
+        perfCounters.end(PERF_PHASE_INPUT);
+
+        // The renderer only sees published steps, interpolated to the display time
+        simulation.update();
+        VehicleState displayed = simulation.stateAt(displayTime);
+        if (canReceiver.isOpen()) {
+            canReceiver.update();
+            copyVehicleFields(displayed, canReceiver.latest().state, canReceiver.latest().fields);
+        }
+        if (candump.isOpen()) {
+            candump.update();
+            copyVehicleFields(displayed, candump.latest().state, candump.latest().fields);
+        }
+        if (udpReceiver.isOpen()) {
+            udpReceiver.update();
+            copyVehicleFields(displayed, udpReceiver.latest().state, udpReceiver.latest().fields);
+        }
+        if (sharedState.isOpen()) {
+            sharedState.poll();
+            copyVehicleFields(displayed, sharedState.state(), sharedState.fields());
+        }
+
+        // Skip the frame when it would look exactly like the last one. Needle
+        // smoothing keeps changing the state, so it never idles mid-animation;
+        // blinking only needs a frame at each on/off edge. Values the cluster
+        // does not show, like the trip counters, do not cause a frame.
+        uint64_t warnings = evaluateWarnings(displayed);
+        signalBus.publish(displayed, warnings);
+        bool blinkOn = blinkPhaseOn(currentTime);
+        bool blinkChanged = warnings != 0 && blinkOn != renderedBlinkOn;
+        if (!headless && !redrawRequested && !blinkChanged && signalBus.changedSince(renderedVersion) == 0) {
+            skippedFrames++;
+            frameStats.skipFrame();
+            if (replay.isOpen())
+                glfwPollEvents();
+            else {
+                // Producers that published while this frame was checked would
+                // not wake the wait, so look once more after arming it
+                idleWake.arm();
+                bool published = simulation.update() | canReceiver.update() | candump.update() |
+                                 udpReceiver.update();
+                if (!published) {
+                    // Shared memory writers cannot wake the wait, so it is
+                    // polled once per refresh instead
+                    double timeout = warnings != 0 ? timeToNextBlinkEdge(currentTime) : IDLE_WAIT_TIMEOUT;
+                    if (sharedState.isOpen())
+                        timeout = std::min(timeout, 1.0 / refreshRate);
+                    glfwWaitEventsTimeout(timeout);
+                }
+                idleWake.disarm();
+            }
+            continue;
+        }
+        renderedVersion = signalBus.version();
+        renderedBlinkOn = blinkOn;
+        redrawRequested = false;
+
+        frameStats.beginFrame();
+        perfCounters.begin(PERF_PHASE_SUBMISSION);
+
+        int framebufferWidth, framebufferHeight;
+        if (headless) {
+            offscreen.bind();
+            framebufferWidth = offscreen.width();
+            framebufferHeight = offscreen.height();
+        }
+        else {
+            glfwGetFramebufferSize(window, &framebufferWidth, &framebufferHeight);
+            glViewport(0, 0, framebufferWidth, framebufferHeight);
+        }
+
+        renderer.setRenderPath(gaugeRenderPath);
+        renderer.setOverlayVisible(gpuOverlayVisible);
+        renderer.render(signalBus, currentTime, framebufferWidth, framebufferHeight);
+
+        uint64_t frameAllocations = AllocationCounter::count() - allocationsAtFrameStart;
+        if (frameCount > 0 && frameAllocations > 0) {
+            hotPathAllocations += frameAllocations;
+            framesWithAllocations++;
+        }
+        frameCount++;
+
+        perfCounters.end(PERF_PHASE_SUBMISSION);
+        frameStats.endSubmission();
+        {
+            PROFILE_ZONE("glfwSwapBuffers");
+            perfCounters.begin(PERF_PHASE_SWAP);
+            if (headless)
+                glFlush();
+            else
+                glfwSwapBuffers(window);
+            perfCounters.end(PERF_PHASE_SWAP);
+        }
+        frameStats.endFrame();
         glfwPollEvents();
+
+        if (statsDumpRequested) {
+            statsDumpRequested = false;
+            if (frameStats.writeJson(FRAME_STATS_PATH))
+                std::cout << "Frame statistics written to " << FRAME_STATS_PATH << "\n";
+        }
+        if (traceDumpRequested) {
+            traceDumpRequested = false;
+            if (Profiler::writeChromeTrace(TRACE_PATH))
+                std::cout << "CPU trace written to " << TRACE_PATH << "\n";
+        }
     }
 
+    // Time the headless run before shutting anything down; the receivers'
+    // stop() can each wait out a socket receive timeout
+    double headlessSeconds = 0.0;
+    if (headless) {
+        glFinish();
+        headlessSeconds = glfwGetTime() - runStartTime;
+    }
+
+    simulation.stop();
+    recorder.close();
+    if (canReceiver.isOpen()) {
+        canReceiver.stop();
+        std::cout << "CAN: " << canReceiver.framesReceived() << " frames received, "
+                  << canReceiver.framesDropped() << " dropped by the kernel\n";
+    }
+    if (candump.isOpen()) {
+        bool finished = candump.finished();
+        candump.stop();
+        std::cout << "CAN log: " << candump.framesReplayed() << " frames over " << std::fixed << std::setprecision(1)
+                  << candump.logSeconds() << " s of log, " << candump.linesSkipped() << " lines skipped";
+        if (finished && candump.elapsedSeconds() > 0.0)
+            std::cout << ", " << std::setprecision(0) << candump.framesReplayed() / candump.elapsedSeconds()
+                      << " frames/s (" << std::setprecision(1) << candump.logSeconds() / candump.elapsedSeconds() << "x real time)";
+        std::cout << "\n" << std::defaultfloat;
+    }
+    if (udpReceiver.isOpen()) {
+        udpReceiver.stop();
+        std::cout << "UDP: " << udpReceiver.packetsReceived() << " packets received, "
+                  << udpReceiver.packetsLost() << " lost, " << udpReceiver.packetsLate() << " late, "
+                  << udpReceiver.packetsRejected() << " rejected\n";
+    }
+    if (replay.isOpen())
+        std::cout << "Replayed " << replay.played() << " of " << replay.size() << " input steps\n";
+
+    if (headless) {
+        std::cout << "Headless: " << frameCount << " frames in " << std::fixed << std::setprecision(3) << headlessSeconds << " s";
+        if (frameCount > 0 && headlessSeconds > 0.0)
+            std::cout << ", " << std::setprecision(1) << frameCount / headlessSeconds << " frames/s, "
+                      << std::setprecision(3) << headlessSeconds * 1000.0 / frameCount << " ms/frame";
+        std::cout << "\n" << std::defaultfloat;
+    }
+
+    frameStats.flush();
+    frameStats.writeJson(FRAME_STATS_PATH);
+    Profiler::writeChromeTrace(TRACE_PATH);
+    perfCounters.report(std::cout);
+    std::cout << "Missed vsync: " << frameStats.missedVsyncCount() << " of " << frameStats.frameCount() << " frames\n";
+
+    std::cout << "Rendered frames: " << frameCount << ", idle frames skipped: " << skippedFrames << "\n";
+    std::cout << "Hot path heap allocations: " << hotPathAllocations
+              << " in " << framesWithAllocations << " of " << (frameCount > 0 ? frameCount - 1 : 0) << " frames after warm-up\n";
+
     glfwTerminate();
     return 0;
 }
\ No newline at end of file